@@ -0,0 +1,446 @@
+#include "Dedup.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <utility>
+
+namespace {
+    // MinHash 签名长度 = 分段数 * 每段行数。6 段 x 3 行时，
+    // Jaccard 0.7 的一对成为候选的概率约 92%，0.8 约 99%，0.3 约 15%。
+    constexpr int kBands = 6;
+    constexpr int kRows = 3;
+    constexpr int kSignature = kBands * kRows;
+
+    // 参与相似度匹配的最少 bigram 数（两首都要达到）。短标题差一个词就能达到 0.7：
+    // "Love Me Do" 与 "Love Me" 为 5/7，"My Love" 与 "My Lover" 为 5/6，它们只参与精确分组。
+    // 8 个 bigram 约为去空白后 9 个字符，"Don't Stop Me"（9 个）仍可与 "Don't Stop Me Now" 匹配。
+    constexpr std::uint32_t kMinFuzzyShingles = 8;
+
+    // 超过这个大小的 LSH 桶不再两两比较，只和桶首及前一个成员比较，避免退化为 O(k^2)
+    constexpr std::size_t kMaxBucketPairs = 64;
+
+    // 每个线程至少处理这么多元素，小输入直接单线程
+    constexpr std::size_t kMinChunk = 4096;
+
+    std::uint64_t mix(std::uint64_t x) {
+        // splitmix64 的终结函数
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    std::uint64_t hash_string(const std::string &s) {
+        std::uint64_t h = 0xcbf29ce484222325ULL; // FNV-1a
+        for (unsigned char c : s) {
+            h ^= c;
+            h *= 0x100000001b3ULL;
+        }
+        return mix(h);
+    }
+
+    // 把 [0, n) 分块交给最多 threads 个线程，fn(begin, end)
+    template <typename F> void parallel_for(std::size_t n, int threads, F fn) {
+        std::size_t workers = std::min<std::size_t>(threads, (n + kMinChunk - 1) / kMinChunk);
+        if (workers <= 1) {
+            fn(std::size_t{0}, n);
+            return;
+        }
+        std::vector<std::thread> pool;
+        pool.reserve(workers);
+        for (std::size_t w = 0; w < workers; ++w) {
+            std::size_t begin = n * w / workers, end = n * (w + 1) / workers;
+            pool.emplace_back([&fn, begin, end] { fn(begin, end); });
+        }
+        for (auto &t : pool)
+            t.join();
+    }
+
+    // ---------- UTF-8 ----------
+
+    // 解码到 cps（复用调用方的缓冲区，避免每个字符串都分配）
+    void decode_utf8(const std::string &s, std::vector<std::uint32_t> &cps) {
+        cps.clear();
+        for (std::size_t i = 0; i < s.size();) {
+            unsigned char c = static_cast<unsigned char>(s[i]);
+            int len = c < 0x80 ? 1 : (c >> 5) == 0x6 ? 2 : (c >> 4) == 0xE ? 3 : (c >> 3) == 0x1E ? 4 : 0;
+            if (len == 0 || i + len > s.size()) { // 非法字节按单字节原样保留
+                cps.push_back(c);
+                ++i;
+                continue;
+            }
+            std::uint32_t cp = len == 1 ? c : c & (0x7F >> len);
+            for (int k = 1; k < len; ++k)
+                cp = (cp << 6) | (static_cast<unsigned char>(s[i + k]) & 0x3F);
+            cps.push_back(cp);
+            i += len;
+        }
+    }
+
+    void append_utf8(std::string &out, std::uint32_t cp) {
+        if (cp < 0x80) {
+            out += static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+
+    // ---------- 归一化 ----------
+
+    std::uint32_t fold(std::uint32_t cp) {
+        if (cp >= 0xFF01 && cp <= 0xFF5E) // 全角 ASCII（含全角括号）
+            cp -= 0xFEE0;
+        else if (cp == 0x3000 || cp == 0x00A0) // 全角空格、不换行空格
+            cp = ' ';
+        if (cp >= 'A' && cp <= 'Z')
+            cp += 'a' - 'A';
+        return cp;
+    }
+
+    bool is_space(std::uint32_t cp) { return cp == ' ' || cp == '\t' || cp == '\n' || cp == '\r'; }
+
+    // ASCII 标点直接丢弃："Don't" 与 "Dont"、"Song!" 与 "Song" 视为相同
+    bool is_punct(std::uint32_t cp) {
+        return cp < 0x80 && cp > ' ' && cp != 0x7F && !(cp >= '0' && cp <= '9') &&
+               !(cp >= 'a' && cp <= 'z');
+    }
+
+    bool is_open(std::uint32_t cp) {
+        switch (cp) {
+        case '(': case '[': case '{':
+        case 0x3008: case 0x300A: case 0x300C: case 0x300E: // 〈 《 「 『
+        case 0x3010: case 0x3014: case 0x3016:             // 【 〔 〖
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool is_close(std::uint32_t cp) {
+        switch (cp) {
+        case ')': case ']': case '}':
+        case 0x3009: case 0x300B: case 0x300D: case 0x300F: // 〉 》 」 』
+        case 0x3011: case 0x3015: case 0x3017:             // 】 〕 〗
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    std::string normalize(const std::vector<std::uint32_t> &cps, bool stripBrackets,
+                          bool dropPunct) {
+        std::string out;
+        out.reserve(cps.size());
+        int depth = 0;
+        bool pendingSpace = false;
+        for (std::uint32_t raw : cps) {
+            std::uint32_t cp = fold(raw);
+            if (stripBrackets) {
+                if (is_open(cp)) {
+                    ++depth;
+                    pendingSpace = true; // "a(b)c" 视为 "a c"
+                    continue;
+                }
+                if (is_close(cp)) {
+                    if (depth > 0)
+                        --depth;
+                    pendingSpace = true;
+                    continue;
+                }
+                if (depth > 0)
+                    continue;
+            }
+            if (is_space(cp)) {
+                pendingSpace = true;
+                continue;
+            }
+            if (dropPunct && is_punct(cp))
+                continue;
+            if (pendingSpace && !out.empty())
+                out += ' ';
+            pendingSpace = false;
+            append_utf8(out, cp);
+        }
+        return out;
+    }
+
+    // ---------- 签名与相似度 ----------
+
+    std::string normalize_with(const std::string &s, std::vector<std::uint32_t> &scratch) {
+        decode_utf8(s, scratch);
+        std::string result = normalize(scratch, true, true);
+        if (result.empty()) // 整个标题都在括号里
+            result = normalize(scratch, false, true);
+        if (result.empty()) // 只有标点，如 "!!!"：保留标点，避免所有这类标题归一化成同一个空串
+            result = normalize(scratch, false, false);
+        return result;
+    }
+
+    // 归一化标题中的数字串，以空格分隔（"symphony no 5" -> "5"，"nocturne op 9 no 2" -> "9 2"）
+    std::string numbers_of(const std::string &normalizedTitle) {
+        std::string result;
+        bool inNumber = false;
+        for (char c : normalizedTitle) {
+            const bool digit = c >= '0' && c <= '9';
+            if (digit && !inNumber && !result.empty())
+                result += ' ';
+            if (digit)
+                result += c;
+            inNumber = digit;
+        }
+        return result;
+    }
+
+    // 码点数，即 shingles 写出元素个数的上界
+    std::size_t count_codepoints(const std::string &s) {
+        std::size_t count = 0;
+        for (unsigned char c : s)
+            count += (c & 0xC0) != 0x80;
+        return count;
+    }
+
+    // 标题去空白后的码点 bigram 哈希（升序去重）写入 out，返回个数；只有一个码点时用该码点本身
+    std::size_t shingles(const std::string &normalizedTitle, std::vector<std::uint32_t> &scratch,
+                         std::uint32_t *out) {
+        decode_utf8(normalizedTitle, scratch);
+        scratch.erase(std::remove(scratch.begin(), scratch.end(), static_cast<std::uint32_t>(' ')),
+                      scratch.end());
+        std::size_t count = 0;
+        if (scratch.size() == 1)
+            out[count++] = static_cast<std::uint32_t>(mix(scratch[0]));
+        for (std::size_t i = 0; i + 1 < scratch.size(); ++i)
+            out[count++] = static_cast<std::uint32_t>(
+                mix((static_cast<std::uint64_t>(scratch[i]) << 32) | scratch[i + 1]));
+        std::sort(out, out + count);
+        return static_cast<std::size_t>(std::unique(out, out + count) - out);
+    }
+
+    double jaccard(const std::uint32_t *a, std::size_t na, const std::uint32_t *b, std::size_t nb) {
+        if (na == 0 || nb == 0)
+            return 0.0;
+        std::size_t i = 0, j = 0, common = 0;
+        while (i < na && j < nb) {
+            if (a[i] < b[j]) {
+                ++i;
+            } else if (b[j] < a[i]) {
+                ++j;
+            } else {
+                ++common;
+                ++i;
+                ++j;
+            }
+        }
+        return static_cast<double>(common) / static_cast<double>(na + nb - common);
+    }
+
+    struct UnionFind {
+        std::vector<std::uint32_t> parent;
+
+        explicit UnionFind(std::size_t n) : parent(n) {
+            std::iota(parent.begin(), parent.end(), 0u);
+        }
+
+        std::uint32_t find(std::uint32_t x) {
+            while (parent[x] != x) {
+                parent[x] = parent[parent[x]]; // 路径减半
+                x = parent[x];
+            }
+            return x;
+        }
+
+        void unite(std::uint32_t a, std::uint32_t b) {
+            a = find(a);
+            b = find(b);
+            if (a != b)
+                parent[std::max(a, b)] = std::min(a, b);
+        }
+    };
+
+    using Keyed = std::pair<std::uint64_t, std::uint32_t>; // (哈希, 下标)
+    using Edge = std::pair<std::uint32_t, std::uint32_t>;
+}
+
+std::string normalize_for_dedup(const std::string &s) {
+    std::vector<std::uint32_t> scratch;
+    return normalize_with(s, scratch);
+}
+
+std::vector<std::vector<int>> find_duplicate_clusters(const std::vector<const Song *> &songs,
+                                                      int threads, double threshold) {
+    if (threads <= 0)
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const std::size_t n = songs.size();
+
+    // 1. 归一化，并按 (艺人, 标题) 的哈希排序以找出完全相同的组
+    std::vector<std::string> artists(n), titles(n);
+    std::vector<Keyed> exact(n);
+    parallel_for(n, threads, [&](std::size_t begin, std::size_t end) {
+        std::vector<std::uint32_t> scratch;
+        for (std::size_t i = begin; i < end; ++i) {
+            artists[i] = normalize_with(songs[i]->artist(), scratch);
+            titles[i] = normalize_with(songs[i]->title(), scratch);
+            exact[i] = {mix(hash_string(artists[i]) ^ (hash_string(titles[i]) * 31)),
+                        static_cast<std::uint32_t>(i)};
+        }
+    });
+    std::sort(exact.begin(), exact.end());
+
+    // 2. 同哈希的一段内按字符串确认相等（防哈希碰撞），每个不同的键选一个代表
+    UnionFind uf(n);
+    std::vector<std::uint32_t> reps;
+    for (std::size_t i = 0; i < n;) {
+        std::size_t j = i;
+        while (j < n && exact[j].first == exact[i].first)
+            ++j;
+        std::size_t firstRep = reps.size();
+        for (std::size_t k = i; k < j; ++k) {
+            std::uint32_t idx = exact[k].second;
+            bool merged = false;
+            for (std::size_t r = firstRep; r < reps.size() && !merged; ++r) {
+                if (artists[reps[r]] == artists[idx] && titles[reps[r]] == titles[idx]) {
+                    uf.unite(reps[r], idx);
+                    merged = true;
+                }
+            }
+            if (!merged)
+                reps.push_back(idx);
+        }
+        i = j;
+    }
+
+    // 3. 每个代表的 bigram 集合（连续存放在 setPool 中，第 r 个从 setBegin[r] 开始，共 setSize[r] 个）
+    //    和 MinHash 签名
+    const std::size_t m = reps.size();
+    std::vector<std::size_t> setBegin(m + 1, 0);
+    for (std::size_t r = 0; r < m; ++r)
+        setBegin[r + 1] = setBegin[r] + std::max<std::size_t>(1, count_codepoints(titles[reps[r]]));
+    std::vector<std::uint32_t> setPool(setBegin[m]);
+    std::vector<std::uint32_t> setSize(m);
+    std::vector<std::uint32_t> signatures(m * kSignature);
+    // 分块键：艺人和标题中的数字串都必须相同（"No. 5" 与 "No. 6" 是不同的作品）
+    std::vector<std::string> numbers(m);
+    std::vector<std::uint64_t> blockHash(m);
+    // 第 k 个哈希函数取 (a_k * x + b_k) >> 32（multiply-shift，2-universal），比逐个做完整混合便宜
+    std::uint64_t mulA[kSignature], addB[kSignature];
+    for (int k = 0; k < kSignature; ++k) {
+        mulA[k] = mix(2 * k + 1) | 1;
+        addB[k] = mix(2 * k + 2);
+    }
+    parallel_for(m, threads, [&](std::size_t begin, std::size_t end) {
+        std::vector<std::uint32_t> scratch;
+        for (std::size_t r = begin; r < end; ++r) {
+            const std::uint32_t *set = &setPool[setBegin[r]];
+            setSize[r] = static_cast<std::uint32_t>(
+                shingles(titles[reps[r]], scratch, &setPool[setBegin[r]]));
+            numbers[r] = numbers_of(titles[reps[r]]);
+            blockHash[r] = mix(hash_string(artists[reps[r]]) ^ (hash_string(numbers[r]) * 31));
+            std::uint32_t *sig = &signatures[r * kSignature];
+            for (int k = 0; k < kSignature; ++k) {
+                std::uint32_t best = UINT32_MAX;
+                for (std::uint32_t i = 0; i < setSize[r]; ++i)
+                    best = std::min(best, static_cast<std::uint32_t>((mulA[k] * set[i] + addB[k]) >> 32));
+                sig[k] = best;
+            }
+        }
+    });
+
+    // 4. LSH：每段一个分桶表，同桶且艺人、数字串相同、相似度达标的代表之间连边。各段并行。
+    //    bigram 太少的短标题不入桶，只参与第 2 步的精确分组。
+    std::vector<std::uint32_t> fuzzy;
+    fuzzy.reserve(m);
+    for (std::size_t r = 0; r < m; ++r) {
+        if (setSize[r] >= kMinFuzzyShingles)
+            fuzzy.push_back(static_cast<std::uint32_t>(r));
+    }
+    const std::size_t f = fuzzy.size();
+    std::vector<std::vector<Edge>> edges(kBands);
+    auto verify = [&](std::uint32_t a, std::uint32_t b, std::vector<Edge> &out) {
+        if (blockHash[a] == blockHash[b] && artists[reps[a]] == artists[reps[b]] &&
+            numbers[a] == numbers[b] &&
+            jaccard(&setPool[setBegin[a]], setSize[a], &setPool[setBegin[b]], setSize[b]) >=
+                threshold)
+            out.emplace_back(a, b);
+    };
+    auto process_band = [&](int band) {
+        std::vector<Keyed> buckets(f);
+        for (std::size_t i = 0; i < f; ++i) {
+            const std::uint32_t r = fuzzy[i];
+            std::uint64_t key = blockHash[r] + band;
+            for (int k = 0; k < kRows; ++k)
+                key = mix(key ^ signatures[r * kSignature + band * kRows + k]);
+            buckets[i] = {key, r};
+        }
+        std::sort(buckets.begin(), buckets.end());
+        for (std::size_t i = 0; i < f;) {
+            std::size_t j = i;
+            while (j < f && buckets[j].first == buckets[i].first)
+                ++j;
+            if (j - i <= kMaxBucketPairs) {
+                for (std::size_t a = i; a < j; ++a)
+                    for (std::size_t b = a + 1; b < j; ++b)
+                        verify(buckets[a].second, buckets[b].second, edges[band]);
+            } else {
+                for (std::size_t a = i + 1; a < j; ++a) {
+                    verify(buckets[i].second, buckets[a].second, edges[band]);
+                    if (a > i + 1)
+                        verify(buckets[a - 1].second, buckets[a].second, edges[band]);
+                }
+            }
+            i = j;
+        }
+    };
+    {
+        const int workers = std::min(threads, kBands);
+        auto run = [&](int w) {
+            for (int band = w; band < kBands; band += workers)
+                process_band(band);
+        };
+        std::vector<std::thread> pool;
+        for (int w = 1; w < workers; ++w)
+            pool.emplace_back(run, w);
+        run(0);
+        for (auto &t : pool)
+            t.join();
+    }
+    for (const auto &bandEdges : edges)
+        for (const Edge &e : bandEdges)
+            uf.unite(reps[e.first], reps[e.second]);
+
+    // 5. 按并查集的根收集簇（只为大小 >= 2 的根建簇）
+    std::vector<std::uint32_t> roots(n), sizes(n, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        roots[i] = uf.find(static_cast<std::uint32_t>(i));
+        ++sizes[roots[i]];
+    }
+    std::vector<std::vector<int>> clusters;
+    std::vector<std::int32_t> clusterOf(n, -1); // 根 -> clusters 下标
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint32_t root = roots[i];
+        if (sizes[root] < 2)
+            continue;
+        if (clusterOf[root] < 0) {
+            clusterOf[root] = static_cast<std::int32_t>(clusters.size());
+            clusters.emplace_back();
+            clusters.back().reserve(sizes[root]);
+        }
+        clusters[clusterOf[root]].push_back(songs[i]->id());
+    }
+    for (auto &c : clusters)
+        std::sort(c.begin(), c.end());
+    std::sort(clusters.begin(), clusters.end());
+    return clusters;
+}
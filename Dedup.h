@@ -0,0 +1,40 @@
+#pragma once
+/**
+ * @file Dedup.h
+ * @brief 近似重复歌曲检测（适用于百万级曲库）。
+ *
+ * 流程：
+ * 1. 归一化标题和艺人：去首尾空白、全角转半角、大小写折叠、删除括号内的后缀
+ *    （如 "告白气球 (Live)"、"Song【Remix】"）和 ASCII 标点、合并连续空白；
+ * 2. 归一化后 (艺人, 标题) 完全相同的歌曲直接归为一组，每组只保留一个代表参与后续步骤；
+ * 3. 对代表的标题字符 bigram 计算 MinHash 签名，按“艺人 + 标题中的数字串 + 签名分段”做 LSH 分桶，
+ *    只有落入同一桶的候选对才计算 Jaccard 相似度，避免两两比较
+ *    （数字串必须完全相同，"Symphony No. 5" 与 "No. 6" 不会被合并）；
+ *    标题太短（去空白后不足约 9 个字符）的歌曲不参与相似度匹配，只按第 2 步精确分组，
+ *    因为短标题差一个词就能超过阈值（"Love Me Do" 与 "Love Me"）；
+ * 4. 相似度达到阈值的候选对用并查集合并成重复簇。
+ * 归一化、签名、分桶和校验均按线程数分块并行。
+ */
+
+#include "Song.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief 查重用的归一化：全角转半角、ASCII 小写、删除括号内容和 ASCII 标点、合并空白并去首尾空白。
+ * 如果删除括号后为空（例如整个标题都在括号里），则保留括号内容；
+ * 如果只剩标点（例如 "!!!"），则保留标点。
+ */
+std::string normalize_for_dedup(const std::string &s);
+
+/**
+ * @brief 查找重复歌曲簇。
+ * @param songs     待检测的歌曲。
+ * @param threads   工作线程数；<= 0 表示使用硬件线程数。
+ * @param threshold 标题 bigram 的 Jaccard 相似度阈值（艺人须归一化后相同，标题中的数字串须完全相同，
+ *                  两个标题都须有足够多的 bigram）。
+ * @return 每个簇为至少两首歌的 ID（升序）；簇之间按首个 ID 升序。
+ */
+std::vector<std::vector<int>> find_duplicate_clusters(const std::vector<const Song *> &songs,
+                                                      int threads = 0, double threshold = 0.7);
@@ -0,0 +1,82 @@
+#pragma once
+/**
+ * @file History.h
+ * @brief 基于快照的撤销/重做历史。
+ *
+ * History 保存一串状态快照：当前状态、可撤销的旧状态栈和可重做的状态栈。
+ * 它本身不关心状态的内容，配合 Playlist 这类持久化结构使用时，
+ * 每次 commit 只是保存一个根指针，代价与播放列表大小无关。
+ *
+ * 可以限制最大撤销深度：撤销栈满时 commit 丢弃最旧的状态，长期运行时内存保持有界。
+ */
+
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <utility>
+
+template <typename T>
+class History {
+  private:
+    T current_;
+    std::deque<T> undo_; // 队尾为上一个状态，队首为最旧的状态
+    std::deque<T> redo_; // 队尾为下一个状态
+    std::size_t maxDepth_;
+
+  public:
+    static constexpr std::size_t kUnlimited = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @param initial  初始状态。
+     * @param maxDepth 最多保留的可撤销状态数（撤销栈与重做栈之和不超过它）；0 表示不保留历史。
+     */
+    explicit History(T initial = T(), std::size_t maxDepth = kUnlimited)
+        : current_(std::move(initial)), maxDepth_(maxDepth) {}
+
+    const T &current() const { return current_; }
+
+    bool can_undo() const { return !undo_.empty(); }
+    bool can_redo() const { return !redo_.empty(); }
+
+    std::size_t max_depth() const { return maxDepth_; }
+
+    /**
+     * @brief 提交一个新状态，原状态入撤销栈，并清空重做栈。
+     * 撤销栈超过最大深度时丢弃最旧的状态（之后无法再撤销到它）。
+     * @param next 新的当前状态。
+     */
+    void commit(T next) {
+        redo_.clear();
+        if (maxDepth_ > 0)
+            undo_.push_back(std::move(current_));
+        if (undo_.size() > maxDepth_)
+            undo_.pop_front();
+        current_ = std::move(next);
+    }
+
+    /**
+     * @brief 回到上一个状态。
+     * @return 如果没有可撤销的状态，返回 false。
+     */
+    bool undo() {
+        if (undo_.empty())
+            return false;
+        redo_.push_back(std::move(current_));
+        current_ = std::move(undo_.back());
+        undo_.pop_back();
+        return true;
+    }
+
+    /**
+     * @brief 重新应用最近一次被撤销的状态。
+     * @return 如果没有可重做的状态，返回 false。
+     */
+    bool redo() {
+        if (redo_.empty())
+            return false;
+        undo_.push_back(std::move(current_));
+        current_ = std::move(redo_.back());
+        redo_.pop_back();
+        return true;
+    }
+};
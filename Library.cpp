@@ -0,0 +1,168 @@
+#include "Library.h"
+
+#include <algorithm>
+#include <utility>
+
+// --- LibrarySnapshot ---
+
+const Song *LibrarySnapshot::find(int id) const {
+    const std::size_t pos = byId.partition_point([id](const Song &s) { return s.id() < id; });
+    if (pos == byId.size() || byId.at(pos).id() != id)
+        return nullptr;
+    return &byId.at(pos);
+}
+
+std::vector<const Song *> LibrarySnapshot::search(const std::string &kw) const {
+    std::vector<const Song *> result;
+    items.for_each([&](const Song &s) {
+        if (s.matches_keyword(kw))
+            result.push_back(&s);
+    });
+    return result;
+}
+
+// --- Library ---
+
+Library::Library(std::size_t maxUndoDepth)
+    : history_(std::make_shared<const LibrarySnapshot>(), maxUndoDepth),
+      current_(history_.current()) {}
+
+Library::Snapshot Library::snapshot() const {
+    return std::atomic_load(&current_);
+}
+
+std::size_t Library::id_position(const Playlist &byId, int id) {
+    return byId.partition_point([id](const Song &s) { return s.id() < id; });
+}
+
+// 歌曲在 items 中的位置：先在 byId 中取得顺序键，再在 items 中按键二分，O(log n)
+long Library::item_position(const LibrarySnapshot &snap, int id) {
+    const std::size_t pos = id_position(snap.byId, id);
+    if (pos == snap.byId.size() || snap.byId.at(pos).id() != id)
+        return -1;
+    return static_cast<long>(snap.items.key_lower_bound(snap.byId.key_at(pos)));
+}
+
+void Library::commit(LibrarySnapshot next) {
+    history_.commit(std::make_shared<const LibrarySnapshot>(std::move(next)));
+    publish();
+}
+
+void Library::publish() {
+    std::atomic_store(&current_, history_.current());
+}
+
+void Library::add(const Song &s) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    const Snapshot cur = history_.current();
+    // 一次分配，items / ranked / byId 和增量共享同一份 Song
+    const auto song = std::make_shared<const Song>(s);
+    const std::size_t pos = id_position(cur->byId, s.id());
+    commit({cur->items.push_back(song, cur->nextKey),
+            cur->ranked.insert(cur->ranked.lower_bound(s), song),
+            cur->byId.insert(pos, song, cur->nextKey),
+            cur->nextKey + 1,
+            {},
+            {song}});
+    stats_.on_added(s);
+}
+
+bool Library::update(int id, const std::function<bool(Song &)> &f) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    const Snapshot cur = history_.current();
+    const long idx = item_position(*cur, id);
+    if (idx < 0)
+        return false;
+
+    const std::shared_ptr<const Song> old = cur->items.shared_at(static_cast<std::size_t>(idx));
+    Song edited = *old;
+    if (!f(edited))
+        return false;
+    const auto next = std::make_shared<const Song>(std::move(edited));
+
+    // ranked 中先删除旧版本，再按新的排序键插入
+    Playlist ranked = cur->ranked.erase(cur->ranked.lower_bound(*old));
+    ranked = ranked.insert(ranked.lower_bound(*next), next);
+    stats_.on_updated(*old, *next);
+    commit({cur->items.set(static_cast<std::size_t>(idx), next),
+            ranked,
+            cur->byId.set(id_position(cur->byId, id), next),
+            cur->nextKey,
+            {old},
+            {next}});
+    return true;
+}
+
+bool Library::remove(int id) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    const Snapshot cur = history_.current();
+    const long idx = item_position(*cur, id);
+    if (idx < 0)
+        return false;
+
+    const std::shared_ptr<const Song> old = cur->items.shared_at(static_cast<std::size_t>(idx));
+    stats_.on_removed(*old);
+    commit({cur->items.erase(static_cast<std::size_t>(idx)),
+            cur->ranked.erase(cur->ranked.lower_bound(*old)),
+            cur->byId.erase(id_position(cur->byId, id)),
+            cur->nextKey,
+            {old},
+            {}});
+    return true;
+}
+
+void Library::sort() {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    const Snapshot cur = history_.current();
+    // 排序后的第 i 首顺序键为 i；byId 按 ID 顺序重建，携带各自的新键
+    const std::vector<std::shared_ptr<const Song>> ranked = cur->ranked.shared_songs();
+    std::vector<long> keys(ranked.size());
+    std::vector<std::pair<int, long>> idKeys(ranked.size());
+    for (std::size_t i = 0; i < ranked.size(); ++i) {
+        keys[i] = static_cast<long>(i);
+        idKeys[i] = {ranked[i]->id(), keys[i]};
+    }
+    std::sort(idKeys.begin(), idKeys.end());
+    const std::vector<std::shared_ptr<const Song>> byId = cur->byId.shared_songs();
+    std::vector<long> byIdKeys(byId.size());
+    for (std::size_t i = 0; i < byId.size(); ++i)
+        byIdKeys[i] = idKeys[i].second;
+    commit({Playlist(ranked, keys),
+            cur->ranked,
+            Playlist(byId, byIdKeys),
+            static_cast<long>(ranked.size()),
+            {},
+            {}});
+}
+
+bool Library::undo() {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    const Snapshot undone = history_.current();
+    if (!history_.undo())
+        return false;
+    // 反向应用被撤销快照的增量
+    for (const auto &s : undone->added)
+        stats_.on_removed(*s);
+    for (const auto &s : undone->removed)
+        stats_.on_added(*s);
+    publish();
+    return true;
+}
+
+bool Library::redo() {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    if (!history_.redo())
+        return false;
+    const Snapshot redone = history_.current();
+    for (const auto &s : redone->removed)
+        stats_.on_removed(*s);
+    for (const auto &s : redone->added)
+        stats_.on_added(*s);
+    publish();
+    return true;
+}
+
+LibraryStats Library::stats() const {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    return stats_;
+}
@@ -0,0 +1,123 @@
+#pragma once
+/**
+ * @file Library.h
+ * @brief 读多写少的曲库：单写者修改，多读者读取一致快照，不等待写者的修改过程。
+ *
+ * Library 的全部状态是一个不可变的 LibrarySnapshot（三个持久化 Playlist）。
+ * - 写者（add / update / remove / sort / undo / redo）在写锁内基于当前快照
+ *   以 O(log n) 的路径复制生成新快照，然后用 std::atomic_store 整体发布；
+ * - 读者调用 snapshot() 通过 std::atomic_load 取得 shared_ptr，不获取写锁。
+ *   注意 shared_ptr 的 atomic_load / atomic_store 并非无锁：libstdc++ 用一个内部互斥锁
+ *   保护指针读取和引用计数（std::atomic_is_lock_free 返回 false），
+ *   因此读者可能与发布中的写者或其他读者短暂竞争这把锁，但临界区只有一次指针复制，
+ *   与曲库大小和写者生成快照的耗时无关。
+ *   读者持有的快照在其生命周期内保持不变，旧快照随最后一个引用释放而回收。
+ *
+ * 写者还维护按艺人/标签的聚合统计（LibraryStats），每次修改只更新受影响的桶；
+ * 撤销/重做时根据快照记录的增量（removed / added）反向或正向修正统计；
+ * 超出撤销深度而被丢弃的快照不会再被撤销，统计因此保持正确。
+ */
+
+#include "History.h"
+#include "Playlist.h"
+#include "Song.h"
+#include "Stats.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 曲库在某一时刻的不可变视图。
+ */
+struct LibrarySnapshot {
+    Playlist items;  // 播放列表顺序（添加顺序，或最近一次排序后的顺序）
+    Playlist ranked; // 始终按 Song::operator< 有序，用于排序列表
+    Playlist byId;   // 始终按 ID 升序，用于 O(log n) 按 ID 查找
+
+    // 播放列表顺序键：items 中的键严格递增，byId 中每首歌携带与 items 中相同的键，
+    // 因此按 ID 找到键后可以在 items 中二分定位，无论 items 是否排过序都是 O(log n)。
+    long nextKey = 0; // 下一首追加歌曲的顺序键
+
+    // 相对上一个快照的增量：被移除的旧版本和新加入的版本（修改 = 移除旧版本 + 加入新版本）。
+    // 与三棵树共享同一份 Song，不额外复制。
+    std::vector<std::shared_ptr<const Song>> removed;
+    std::vector<std::shared_ptr<const Song>> added;
+
+    /**
+     * @brief 按 ID 查找歌曲，O(log n)。
+     * @return 找到时返回指向快照内歌曲的指针（随快照一同有效）；否则返回 nullptr。
+     */
+    const Song *find(int id) const;
+
+    /**
+     * @brief 按播放列表顺序返回所有匹配关键词的歌曲（见 Song::matches_keyword）。
+     */
+    std::vector<const Song *> search(const std::string &kw) const;
+};
+
+class Library {
+  public:
+    using Snapshot = std::shared_ptr<const LibrarySnapshot>;
+
+    // 默认最多保留的撤销步数
+    static constexpr std::size_t kDefaultUndoDepth = 256;
+
+    /**
+     * @param maxUndoDepth 最多保留的撤销步数；更早的快照被丢弃并回收，长期运行时内存保持有界。
+     */
+    explicit Library(std::size_t maxUndoDepth = kDefaultUndoDepth);
+
+    /**
+     * @brief 取得当前快照（可在任意线程调用；只在复制指针时短暂持有 atomic_load 的内部锁，不等待写锁）。
+     */
+    Snapshot snapshot() const;
+
+    // --- 写操作（可在任意线程调用，内部串行化） ---
+
+    /**
+     * @brief 追加一首（已校验的）歌曲。
+     */
+    void add(const Song &s);
+
+    /**
+     * @brief 在指定歌曲的副本上调用 f，f 返回 true 时提交修改。
+     * @param id 歌曲 ID。
+     * @param f  修改函数，例如调用 Song 的 setter。
+     * @return 找到歌曲且 f 返回 true 时返回 true。
+     */
+    bool update(int id, const std::function<bool(Song &)> &f);
+
+    /**
+     * @brief 删除指定 ID 的歌曲。
+     * @return 未找到时返回 false。
+     */
+    bool remove(int id);
+
+    /**
+     * @brief 把播放列表顺序设为按 operator< 排序后的顺序，并重新分配顺序键（O(n log n)）。
+     */
+    void sort();
+
+    bool undo();
+    bool redo();
+
+    /**
+     * @brief 返回当前聚合统计的副本（短暂持有写锁，代价与艺人/标签数成正比）。
+     */
+    LibraryStats stats() const;
+
+  private:
+    mutable std::mutex write_mutex_;   // 串行化写者；读者从不获取
+    History<Snapshot> history_;        // 受 write_mutex_ 保护
+    Snapshot current_;                 // 只通过 atomic_load / atomic_store 访问
+    LibraryStats stats_;               // 受 write_mutex_ 保护
+
+    void commit(LibrarySnapshot next);
+    static std::size_t id_position(const Playlist &byId, int id);
+    static long item_position(const LibrarySnapshot &snap, int id);
+    void publish();
+};
@@ -0,0 +1,237 @@
+#include "Playlist.h"
+
+#include <algorithm>
+
+// 树操作的实现：所有函数都只创建新节点，从不修改已有节点
+struct Playlist::Impl {
+    // 节点中除子树以外的内容：歌曲和顺序键
+    struct Item {
+        std::shared_ptr<const Song> song;
+        long key;
+    };
+
+    static std::size_t size_of(const NodePtr &n) { return n ? n->size : 0; }
+    static int height_of(const NodePtr &n) { return n ? n->height : 0; }
+    static Item item_of(const NodePtr &n) { return {n->song, n->key}; }
+
+    static NodePtr make(NodePtr l, Item it, NodePtr r) {
+        return std::make_shared<const Node>(std::move(l), std::move(it.song), it.key, std::move(r));
+    }
+
+    // 由左右子树和中间歌曲组成新节点，必要时做一次（单/双）旋转恢复 AVL 平衡
+    static NodePtr balance(NodePtr l, Item it, NodePtr r) {
+        const int hl = height_of(l);
+        const int hr = height_of(r);
+        if (hl > hr + 1) {
+            if (height_of(l->left) >= height_of(l->right)) {
+                return make(l->left, item_of(l), make(l->right, std::move(it), std::move(r)));
+            }
+            const NodePtr &lr = l->right;
+            return make(make(l->left, item_of(l), lr->left), item_of(lr),
+                        make(lr->right, std::move(it), std::move(r)));
+        }
+        if (hr > hl + 1) {
+            if (height_of(r->right) >= height_of(r->left)) {
+                return make(make(std::move(l), std::move(it), r->left), item_of(r), r->right);
+            }
+            const NodePtr &rl = r->left;
+            return make(make(std::move(l), std::move(it), rl->left), item_of(rl),
+                        make(rl->right, item_of(r), r->right));
+        }
+        return make(std::move(l), std::move(it), std::move(r));
+    }
+
+    static NodePtr insert_at(const NodePtr &n, std::size_t i, Item it) {
+        if (!n)
+            return make(nullptr, std::move(it), nullptr);
+        const std::size_t ls = size_of(n->left);
+        if (i <= ls)
+            return balance(insert_at(n->left, i, std::move(it)), item_of(n), n->right);
+        return balance(n->left, item_of(n), insert_at(n->right, i - ls - 1, std::move(it)));
+    }
+
+    static NodePtr set_at(const NodePtr &n, std::size_t i, std::shared_ptr<const Song> s) {
+        const std::size_t ls = size_of(n->left);
+        if (i < ls)
+            return make(set_at(n->left, i, std::move(s)), item_of(n), n->right);
+        if (i > ls)
+            return make(n->left, item_of(n), set_at(n->right, i - ls - 1, std::move(s)));
+        return make(n->left, {std::move(s), n->key}, n->right);
+    }
+
+    // 删除子树中最左的节点，被删除的内容通过 out 返回
+    static NodePtr erase_min(const NodePtr &n, Item &out) {
+        if (!n->left) {
+            out = item_of(n);
+            return n->right;
+        }
+        return balance(erase_min(n->left, out), item_of(n), n->right);
+    }
+
+    static NodePtr erase_at(const NodePtr &n, std::size_t i) {
+        const std::size_t ls = size_of(n->left);
+        if (i < ls)
+            return balance(erase_at(n->left, i), item_of(n), n->right);
+        if (i > ls)
+            return balance(n->left, item_of(n), erase_at(n->right, i - ls - 1));
+        if (!n->left)
+            return n->right;
+        if (!n->right)
+            return n->left;
+        Item successor{nullptr, 0};
+        NodePtr r = erase_min(n->right, successor);
+        return balance(n->left, std::move(successor), std::move(r));
+    }
+
+    // 由有序的歌曲指针区间 [lo, hi) 构造完全平衡的树；keys 为空时顺序键取位置
+    static NodePtr build(const std::vector<std::shared_ptr<const Song>> &songs,
+                         const std::vector<long> &keys, std::size_t lo, std::size_t hi) {
+        if (lo >= hi)
+            return nullptr;
+        const std::size_t mid = lo + (hi - lo) / 2;
+        const long key = keys.empty() ? static_cast<long>(mid) : keys[mid];
+        return make(build(songs, keys, lo, mid), {songs[mid], key}, build(songs, keys, mid + 1, hi));
+    }
+
+    static void collect(const NodePtr &n, std::vector<std::shared_ptr<const Song>> &out) {
+        if (!n)
+            return;
+        collect(n->left, out);
+        out.push_back(n->song);
+        collect(n->right, out);
+    }
+
+    static const Node *node_at(const NodePtr &root, std::size_t i) {
+        const Node *n = root.get();
+        for (;;) {
+            const std::size_t ls = size_of(n->left);
+            if (i < ls) {
+                n = n->left.get();
+            } else if (i > ls) {
+                i -= ls + 1;
+                n = n->right.get();
+            } else {
+                return n;
+            }
+        }
+    }
+};
+
+Playlist::Node::Node(NodePtr l, std::shared_ptr<const Song> s, long k, NodePtr r)
+    : left(std::move(l)),
+      song(std::move(s)),
+      key(k),
+      right(std::move(r)),
+      size(Impl::size_of(left) + Impl::size_of(right) + 1),
+      height(std::max(Impl::height_of(left), Impl::height_of(right)) + 1) {}
+
+Playlist::Playlist(const std::vector<Song> &songs) {
+    std::vector<std::shared_ptr<const Song>> ptrs;
+    ptrs.reserve(songs.size());
+    for (const auto &s : songs) {
+        ptrs.push_back(std::make_shared<const Song>(s));
+    }
+    root_ = Impl::build(ptrs, {}, 0, ptrs.size());
+}
+
+Playlist::Playlist(const std::vector<std::shared_ptr<const Song>> &songs,
+                   const std::vector<long> &keys)
+    : root_(Impl::build(songs, keys, 0, songs.size())) {}
+
+std::size_t Playlist::size() const {
+    return Impl::size_of(root_);
+}
+
+const Song &Playlist::at(std::size_t i) const {
+    return *Impl::node_at(root_, i)->song;
+}
+
+const std::shared_ptr<const Song> &Playlist::shared_at(std::size_t i) const {
+    return Impl::node_at(root_, i)->song;
+}
+
+long Playlist::key_at(std::size_t i) const {
+    return Impl::node_at(root_, i)->key;
+}
+
+std::size_t Playlist::key_lower_bound(long key) const {
+    std::size_t pos = 0;
+    const Node *n = root_.get();
+    while (n) {
+        if (n->key < key) {
+            pos += Impl::size_of(n->left) + 1;
+            n = n->right.get();
+        } else {
+            n = n->left.get();
+        }
+    }
+    return pos;
+}
+
+std::vector<std::shared_ptr<const Song>> Playlist::shared_songs() const {
+    std::vector<std::shared_ptr<const Song>> songs;
+    songs.reserve(size());
+    Impl::collect(root_, songs);
+    return songs;
+}
+
+long Playlist::index_of(int id) const {
+    // 显式栈的中序遍历，找到即返回
+    std::vector<const Node *> stack;
+    long idx = 0;
+    const Node *n = root_.get();
+    while (n || !stack.empty()) {
+        while (n) {
+            stack.push_back(n);
+            n = n->left.get();
+        }
+        n = stack.back();
+        stack.pop_back();
+        if (n->song->id() == id)
+            return idx;
+        ++idx;
+        n = n->right.get();
+    }
+    return -1;
+}
+
+std::size_t Playlist::lower_bound(const Song &s) const {
+    return partition_point([&](const Song &x) { return x < s; });
+}
+
+Playlist Playlist::push_back(const Song &s) const {
+    return push_back(std::make_shared<const Song>(s));
+}
+
+Playlist Playlist::push_back(std::shared_ptr<const Song> s, long key) const {
+    return insert(size(), std::move(s), key);
+}
+
+Playlist Playlist::insert(std::size_t i, const Song &s) const {
+    return insert(i, std::make_shared<const Song>(s));
+}
+
+Playlist Playlist::insert(std::size_t i, std::shared_ptr<const Song> s, long key) const {
+    return Playlist(Impl::insert_at(root_, i, {std::move(s), key}));
+}
+
+Playlist Playlist::set(std::size_t i, const Song &s) const {
+    return set(i, std::make_shared<const Song>(s));
+}
+
+Playlist Playlist::set(std::size_t i, std::shared_ptr<const Song> s) const {
+    return Playlist(Impl::set_at(root_, i, std::move(s)));
+}
+
+Playlist Playlist::erase(std::size_t i) const {
+    return Playlist(Impl::erase_at(root_, i));
+}
+
+Playlist Playlist::sorted() const {
+    std::vector<std::shared_ptr<const Song>> songs = shared_songs();
+    std::sort(songs.begin(), songs.end(),
+              [](const std::shared_ptr<const Song> &a, const std::shared_ptr<const Song> &b) {
+                  return *a < *b;
+              });
+    return Playlist(Impl::build(songs, {}, 0, songs.size()));
+}
@@ -0,0 +1,172 @@
+#pragma once
+/**
+ * @file Playlist.h
+ * @brief 持久化（结构共享）播放列表的定义。
+ *
+ * Playlist 是一个不可变的、按位置索引的序列，内部使用路径复制的 AVL 树实现：
+ * - 复制一个 Playlist（即“拍快照”）只复制一个根指针，O(1)；
+ * - push_back / set / erase 返回新的 Playlist，只复制从根到目标位置的 O(log n) 个节点，
+ *   其余节点与旧版本共享；
+ * - 歌曲本身以 shared_ptr<const Song> 存放，路径复制时不会复制 Song 的字符串和标签；
+ *   接受 shared_ptr 的重载让多个 Playlist（以及调用方）共享同一份 Song，只分配一次；
+ * - 每个位置还可以携带一个由调用方定义的顺序键（long，默认 0），Playlist 本身不解释它。
+ *   如果调用方保证键沿列表严格递增，就可以用 key_lower_bound 按键 O(log n) 定位。
+ *
+ * 因为旧版本永远不会被修改，多个快照可以同时存在（用于撤销/重做），内存只随改动量增长。
+ */
+
+#include "Song.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class Playlist {
+  private:
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    /**
+     * @brief 树节点（创建后不可变）。
+     */
+    struct Node {
+        NodePtr left;
+        std::shared_ptr<const Song> song;
+        long key;         // 调用方定义的顺序键
+        NodePtr right;
+        std::size_t size; // 子树中的歌曲数量
+        int height;       // 子树高度（叶子为 1）
+
+        Node(NodePtr l, std::shared_ptr<const Song> s, long k, NodePtr r);
+    };
+
+    struct Impl; // 树操作的实现细节（见 Playlist.cpp）
+
+    NodePtr root_;
+
+    explicit Playlist(NodePtr root) : root_(std::move(root)) {}
+
+    template <typename F>
+    static void visit(const NodePtr &n, F &f) {
+        if (!n)
+            return;
+        visit(n->left, f);
+        f(*n->song);
+        visit(n->right, f);
+    }
+
+  public:
+    /**
+     * @brief 构造空播放列表。
+     */
+    Playlist() = default;
+
+    /**
+     * @brief 从按顺序排列的歌曲构造播放列表（O(n) 建树），顺序键为位置 0..n-1。
+     * @param songs 歌曲序列。
+     */
+    explicit Playlist(const std::vector<Song> &songs);
+
+    /**
+     * @brief 从按顺序排列的歌曲指针构造播放列表（O(n) 建树），第 i 首的顺序键为 keys[i]。
+     * @param songs 歌曲序列（与调用方共享，不复制 Song）。
+     * @param keys  顺序键，长度须与 songs 相同。
+     */
+    Playlist(const std::vector<std::shared_ptr<const Song>> &songs, const std::vector<long> &keys);
+
+    std::size_t size() const;
+    bool empty() const { return !root_; }
+
+    /**
+     * @brief 访问第 i 首歌曲（0 起始），O(log n)。调用方需保证 i < size()。
+     */
+    const Song &at(std::size_t i) const;
+
+    /**
+     * @brief 返回第 i 首歌曲的共享指针，O(log n)，可用于把同一份 Song 放入其他 Playlist。
+     */
+    const std::shared_ptr<const Song> &shared_at(std::size_t i) const;
+
+    /**
+     * @brief 第 i 首歌曲的顺序键，O(log n)。
+     */
+    long key_at(std::size_t i) const;
+
+    /**
+     * @brief 在顺序键严格递增的播放列表中，返回第一个键不小于 key 的位置，O(log n)。
+     */
+    std::size_t key_lower_bound(long key) const;
+
+    /**
+     * @brief 按 ID 查找歌曲的位置。
+     * @return 找到时返回下标；否则返回 -1。
+     */
+    long index_of(int id) const;
+
+    /**
+     * @brief 在按 operator< 有序的播放列表中，返回第一个不“小于” s 的位置，O(log n)。
+     */
+    std::size_t lower_bound(const Song &s) const;
+
+    /**
+     * @brief 二分查找：列表需按 pred 划分（先全为 true，后全为 false），
+     *        返回第一个使 pred(song) 为 false 的位置，O(log n)。
+     */
+    template <typename Pred>
+    std::size_t partition_point(Pred pred) const {
+        std::size_t pos = 0;
+        const Node *n = root_.get();
+        while (n) {
+            if (pred(*n->song)) {
+                pos += (n->left ? n->left->size : 0) + 1;
+                n = n->right.get();
+            } else {
+                n = n->left.get();
+            }
+        }
+        return pos;
+    }
+
+    /**
+     * @brief 按顺序返回所有歌曲的共享指针，O(n)。
+     */
+    std::vector<std::shared_ptr<const Song>> shared_songs() const;
+
+    // --- 修改操作（均返回新版本，原对象不变） ---
+
+    /**
+     * @brief 在末尾追加一首歌曲，O(log n)。
+     */
+    Playlist push_back(const Song &s) const;
+    Playlist push_back(std::shared_ptr<const Song> s, long key = 0) const;
+
+    /**
+     * @brief 在位置 i（0..size()）插入一首歌曲，O(log n)。
+     */
+    Playlist insert(std::size_t i, const Song &s) const;
+    Playlist insert(std::size_t i, std::shared_ptr<const Song> s, long key = 0) const;
+
+    /**
+     * @brief 用 s 替换第 i 首歌曲（保留该位置的顺序键），O(log n)。
+     */
+    Playlist set(std::size_t i, const Song &s) const;
+    Playlist set(std::size_t i, std::shared_ptr<const Song> s) const;
+
+    /**
+     * @brief 删除第 i 首歌曲，O(log n)。
+     */
+    Playlist erase(std::size_t i) const;
+
+    /**
+     * @brief 返回按 Song::operator< 排好序的新版本（顺序键为新位置 0..n-1），O(n log n)。
+     */
+    Playlist sorted() const;
+
+    /**
+     * @brief 按顺序对每首歌曲调用 f(const Song&)。
+     */
+    template <typename F>
+    void for_each(F f) const {
+        visit(root_, f);
+    }
+};
@@ -0,0 +1,710 @@
+#include "Server.h"
+
+#include "Dedup.h"
+#include "SetBuilder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <csignal>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    // 单个连接最多积压的未完成响应数；超过后暂停读取该连接，直到响应被写出
+    const std::size_t kMaxPending = 1024;
+    // 单次 read 的缓冲大小
+    const std::size_t kReadChunk = 64 * 1024;
+    // 单个请求行的最大字节数；超过后返回 ERR，未结束的超长行还会停止读取该连接
+    const std::size_t kMaxLine = 64 * 1024;
+
+    // epoll 事件的 data.u64 标记；连接从 kFirstConn 开始编号
+    const std::uint64_t kListenTag = 0;
+    const std::uint64_t kWakeTag = 1;
+    const std::uint64_t kSignalTag = 2;
+    const std::uint64_t kFirstConn = 3;
+
+    // --- 字符串辅助 ---
+
+    std::string trim_copy(const std::string &s) {
+        const std::string whitespace = " \t\n\r";
+        size_t start = s.find_first_not_of(whitespace);
+        if (start == std::string::npos)
+            return "";
+        size_t end = s.find_last_not_of(whitespace);
+        return s.substr(start, end - start + 1);
+    }
+
+    std::vector<std::string> split_tabs(const std::string &line) {
+        std::vector<std::string> fields;
+        size_t start = 0;
+        for (;;) {
+            size_t tab = line.find('\t', start);
+            if (tab == std::string::npos) {
+                fields.push_back(line.substr(start));
+                return fields;
+            }
+            fields.push_back(line.substr(start, tab - start));
+            start = tab + 1;
+        }
+    }
+
+    // 解析正整数（纯数字，允许首尾空白）
+    bool parse_positive_int(const std::string &text, int &out) {
+        const std::string s = trim_copy(text);
+        if (s.empty() || s.size() > 9)
+            return false;
+        int value = 0;
+        for (const char ch : s) {
+            if (!isdigit(static_cast<unsigned char>(ch)))
+                return false;
+            value = value * 10 + (ch - '0');
+        }
+        if (value <= 0)
+            return false;
+        out = value;
+        return true;
+    }
+
+    // --- 响应格式 ---
+
+    std::string ok_songs(const std::vector<const Song *> &songs) {
+        std::ostringstream oss;
+        oss << "OK\t" << songs.size() << "\n";
+        for (const Song *s : songs)
+            oss << *s << "\n";
+        return oss.str();
+    }
+
+    std::string ok_song(const Song &s) {
+        return ok_songs({&s});
+    }
+
+    // 每个重复簇一行，ID 以空格分隔
+    std::string ok_clusters(const std::vector<std::vector<int>> &clusters) {
+        std::ostringstream oss;
+        oss << "OK\t" << clusters.size() << "\n";
+        for (const auto &c : clusters) {
+            for (std::size_t i = 0; i < c.size(); ++i)
+                oss << (i ? " " : "") << c[i];
+            oss << "\n";
+        }
+        return oss.str();
+    }
+
+    std::string ok_empty() {
+        return "OK\t0\n";
+    }
+
+    std::string err(const std::string &msg) {
+        return "ERR\t" + msg + "\n";
+    }
+
+    // 删除上次运行遗留的套接字文件；path 存在但不是套接字时拒绝删除（多半是路径写错了）
+    bool remove_stale_socket(const std::string &path) {
+        struct stat st {};
+        if (lstat(path.c_str(), &st) != 0) {
+            if (errno == ENOENT)
+                return true;
+            std::perror("lstat");
+            return false;
+        }
+        if (!S_ISSOCK(st.st_mode)) {
+            std::cerr << "[错误] " << path << " 已存在且不是套接字，拒绝覆盖\n";
+            return false;
+        }
+        if (unlink(path.c_str()) != 0) {
+            std::perror("unlink");
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<const Song *> collect(const Playlist &pl) {
+        std::vector<const Song *> songs;
+        songs.reserve(pl.size());
+        pl.for_each([&](const Song &s) { songs.push_back(&s); });
+        return songs;
+    }
+
+    /**
+     * @brief 一个请求的响应槽，按请求顺序排在连接的 pending 队列中。
+     */
+    struct Slot {
+        std::string out;
+        std::atomic<bool> ready{false};
+    };
+    using SlotPtr = std::shared_ptr<Slot>;
+
+    SlotPtr ready_slot(const std::string &out) {
+        auto slot = std::make_shared<Slot>();
+        slot->out = out;
+        slot->ready = true;
+        return slot;
+    }
+
+    /**
+     * @brief 固定大小的工作线程池，按提交顺序执行任务。
+     */
+    class WorkerPool {
+      public:
+        explicit WorkerPool(int n) {
+            for (int i = 0; i < n; ++i)
+                threads_.emplace_back([this]() { work(); });
+        }
+
+        ~WorkerPool() { shutdown(); }
+
+        void submit(std::function<void()> job) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                jobs_.push_back(std::move(job));
+            }
+            cv_.notify_one();
+        }
+
+        // 执行完已提交的任务后停止所有线程
+        void shutdown() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            cv_.notify_all();
+            for (auto &t : threads_)
+                t.join();
+            threads_.clear();
+        }
+
+      private:
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::deque<std::function<void()>> jobs_;
+        bool stop_ = false;
+        std::vector<std::thread> threads_;
+
+        void work() {
+            for (;;) {
+                std::function<void()> job;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cv_.wait(lock, [this]() { return stop_ || !jobs_.empty(); });
+                    if (jobs_.empty())
+                        return;
+                    job = std::move(jobs_.front());
+                    jobs_.pop_front();
+                }
+                job();
+            }
+        }
+    };
+
+    struct Connection {
+        int fd = -1;
+        std::string in;               // 尚未处理的输入
+        std::string out;              // 待写出的响应
+        std::size_t outOff = 0;       // out 中已写出的字节数
+        std::deque<SlotPtr> pending;  // 按请求顺序排列的响应槽
+        bool throttled = false;       // pending 过多时暂停读取
+        bool inputClosed = false;     // 对端已关闭写方向：不再读取，写完响应后关闭
+        bool discarding = false;      // 遇到超长行后丢弃其余输入，直到对端关闭写方向
+        std::uint32_t events = 0;     // 当前在 epoll 中注册的事件
+    };
+
+    class Server {
+      public:
+        Server(Library &lib, int workers) : lib_(lib), pool_(workers) {}
+
+        int run(const std::string &path, int sigFd);
+
+      private:
+        Library &lib_;
+        WorkerPool pool_;
+        int epollFd_ = -1;
+        int wakeFd_ = -1;
+        int listenFd_ = -1;
+        bool acceptPaused_ = false; // 文件描述符耗尽时暂停监听，有连接关闭后恢复
+        std::uint64_t nextConn_ = kFirstConn;
+        std::map<std::uint64_t, Connection> conns_;
+
+        std::mutex doneMutex_;                // 保护 done_
+        std::vector<std::uint64_t> done_;     // 有响应完成的连接
+
+        void accept_all();
+        void set_accepting(bool on);
+        void on_readable(std::uint64_t id);
+        void on_wake();
+        void process_lines(std::uint64_t id, Connection &c);
+        void flush(std::uint64_t id);
+        void update_events(std::uint64_t id, Connection &c);
+        void close_conn(std::uint64_t id);
+
+        SlotPtr handle(std::uint64_t id, const std::string &line);
+        std::string execute_write(const std::vector<std::string> &f);
+        void submit_read(std::uint64_t id, const SlotPtr &slot, std::function<std::string()> job);
+    };
+
+    int Server::run(const std::string &path, int sigFd) {
+        const int listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        listenFd_ = listenFd;
+        if (listenFd < 0) {
+            std::perror("socket");
+            return 1;
+        }
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(addr.sun_path)) {
+            std::cerr << "[错误] 套接字路径过长\n";
+            close(listenFd);
+            return 1;
+        }
+        std::copy(path.begin(), path.end(), addr.sun_path);
+        if (!remove_stale_socket(path)) {
+            close(listenFd);
+            return 1;
+        }
+        if (bind(listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 ||
+            listen(listenFd, 128) < 0) {
+            std::perror("bind/listen");
+            close(listenFd);
+            return 1;
+        }
+
+        epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+        wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = kListenTag;
+        epoll_ctl(epollFd_, EPOLL_CTL_ADD, listenFd, &ev);
+        ev.data.u64 = kWakeTag;
+        epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &ev);
+        ev.data.u64 = kSignalTag;
+        epoll_ctl(epollFd_, EPOLL_CTL_ADD, sigFd, &ev);
+
+        std::cout << "[服务] 正在监听 " << path << std::endl;
+
+        bool running = true;
+        std::vector<epoll_event> events(64);
+        while (running) {
+            const int n = epoll_wait(epollFd_, events.data(), static_cast<int>(events.size()), -1);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                std::perror("epoll_wait");
+                break;
+            }
+            for (int i = 0; i < n; ++i) {
+                const std::uint64_t tag = events[i].data.u64;
+                const std::uint32_t what = events[i].events;
+                if (tag == kListenTag) {
+                    accept_all();
+                } else if (tag == kWakeTag) {
+                    on_wake();
+                } else if (tag == kSignalTag) {
+                    running = false;
+                } else if (conns_.count(tag)) {
+                    if (what & EPOLLIN) {
+                        on_readable(tag);
+                    } else if (what & (EPOLLHUP | EPOLLERR)) {
+                        close_conn(tag);
+                        continue;
+                    }
+                    if ((what & EPOLLOUT) && conns_.count(tag))
+                        flush(tag);
+                }
+            }
+        }
+
+        pool_.shutdown();
+        while (!conns_.empty())
+            close_conn(conns_.begin()->first);
+        close(listenFd);
+        unlink(path.c_str());
+        close(wakeFd_);
+        close(epollFd_);
+        std::cout << "[服务] 已停止" << std::endl;
+        return 0;
+    }
+
+    void Server::accept_all() {
+        for (;;) {
+            const int fd = accept4(listenFd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR || errno == ECONNABORTED)
+                    continue;
+                // EMFILE / ENFILE / ENOBUFS 等：监听套接字是水平触发的，不暂停会空转占满 CPU
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    std::perror("accept4");
+                    set_accepting(false);
+                }
+                return;
+            }
+            const std::uint64_t id = nextConn_++;
+            Connection &c = conns_[id];
+            c.fd = fd;
+            c.events = EPOLLIN;
+            epoll_event ev{};
+            ev.events = c.events;
+            ev.data.u64 = id;
+            epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &ev);
+        }
+    }
+
+    void Server::set_accepting(bool on) {
+        if (acceptPaused_ == !on)
+            return;
+        acceptPaused_ = !on;
+        epoll_event ev{};
+        ev.events = on ? static_cast<std::uint32_t>(EPOLLIN) : 0u;
+        ev.data.u64 = kListenTag;
+        epoll_ctl(epollFd_, EPOLL_CTL_MOD, listenFd_, &ev);
+    }
+
+    void Server::on_readable(std::uint64_t id) {
+        Connection &c = conns_[id];
+        char buf[kReadChunk];
+        const ssize_t n = read(c.fd, buf, sizeof(buf));
+        if (n < 0 && errno != EAGAIN && errno != EINTR) {
+            close_conn(id);
+            return;
+        }
+        if (n > 0 && !c.discarding)
+            c.in.append(buf, static_cast<std::size_t>(n));
+        if (n == 0) {
+            // 对端半关闭（如 shutdown(SHUT_WR)）：处理完已收到的请求、写完所有响应后再关闭
+            c.inputClosed = true;
+            if (!c.in.empty() && c.in.back() != '\n')
+                c.in += '\n';
+        }
+        process_lines(id, c);
+        flush(id);
+    }
+
+    void Server::process_lines(std::uint64_t id, Connection &c) {
+        std::size_t start = 0;
+        while (c.pending.size() < kMaxPending) {
+            const std::size_t nl = c.in.find('\n', start);
+            if (nl == std::string::npos)
+                break;
+            std::string line = c.in.substr(start, nl - start);
+            start = nl + 1;
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (line.empty())
+                continue;
+            c.pending.push_back(line.size() > kMaxLine ? ready_slot(err("请求行过长"))
+                                                       : handle(id, line));
+        }
+        c.in.erase(0, start);
+        c.throttled = c.pending.size() >= kMaxPending;
+
+        // 迟迟没有换行的超长行：无法再找到请求边界，回复错误后丢弃其余输入
+        if (!c.throttled && !c.discarding && c.in.size() > kMaxLine) {
+            c.pending.push_back(ready_slot(err("请求行过长")));
+            c.in.clear();
+            c.discarding = true;
+        }
+    }
+
+    void Server::on_wake() {
+        std::uint64_t counter = 0;
+        while (read(wakeFd_, &counter, sizeof(counter)) > 0) {
+        }
+        std::vector<std::uint64_t> ids;
+        {
+            std::lock_guard<std::mutex> lock(doneMutex_);
+            ids.swap(done_);
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        for (const std::uint64_t id : ids) {
+            if (conns_.count(id))
+                flush(id);
+        }
+    }
+
+    void Server::flush(std::uint64_t id) {
+        Connection &c = conns_[id];
+        for (;;) {
+            // 按顺序收集已就绪的响应
+            while (!c.pending.empty() && c.pending.front()->ready.load(std::memory_order_acquire)) {
+                c.out += c.pending.front()->out;
+                c.pending.pop_front();
+            }
+
+            while (c.outOff < c.out.size()) {
+                const ssize_t n = send(c.fd, c.out.data() + c.outOff, c.out.size() - c.outOff,
+                                       MSG_NOSIGNAL);
+                if (n < 0) {
+                    if (errno == EAGAIN || errno == EINTR)
+                        break;
+                    close_conn(id);
+                    return;
+                }
+                c.outOff += static_cast<std::size_t>(n);
+            }
+            if (c.outOff == c.out.size()) {
+                c.out.clear();
+                c.outOff = 0;
+            }
+
+            // 解除限流后继续处理已缓冲的请求
+            if (c.throttled && c.pending.size() < kMaxPending) {
+                process_lines(id, c);
+                if (!c.pending.empty() && c.pending.front()->ready.load(std::memory_order_acquire))
+                    continue;
+            }
+            break;
+        }
+        if (c.inputClosed && !c.throttled && c.pending.empty() && c.out.empty()) {
+            close_conn(id);
+            return;
+        }
+        update_events(id, c);
+    }
+
+    void Server::update_events(std::uint64_t id, Connection &c) {
+        std::uint32_t want = 0;
+        if (!c.throttled && !c.inputClosed)
+            want |= EPOLLIN;
+        if (!c.out.empty())
+            want |= EPOLLOUT;
+        if (want == c.events)
+            return;
+        c.events = want;
+        epoll_event ev{};
+        ev.events = want;
+        ev.data.u64 = id;
+        epoll_ctl(epollFd_, EPOLL_CTL_MOD, c.fd, &ev);
+    }
+
+    void Server::close_conn(std::uint64_t id) {
+        auto it = conns_.find(id);
+        if (it == conns_.end())
+            return;
+        epoll_ctl(epollFd_, EPOLL_CTL_DEL, it->second.fd, nullptr);
+        close(it->second.fd);
+        conns_.erase(it);
+        set_accepting(true);
+    }
+
+    void Server::submit_read(std::uint64_t id, const SlotPtr &slot,
+                             std::function<std::string()> job) {
+        pool_.submit([this, id, slot, job]() {
+            slot->out = job();
+            slot->ready.store(true, std::memory_order_release);
+            {
+                std::lock_guard<std::mutex> lock(doneMutex_);
+                done_.push_back(id);
+            }
+            const std::uint64_t one = 1;
+            ssize_t ignored = write(wakeFd_, &one, sizeof(one));
+            (void)ignored;
+        });
+    }
+
+    SlotPtr Server::handle(std::uint64_t id, const std::string &line) {
+        auto slot = std::make_shared<Slot>();
+        const std::vector<std::string> f = split_tabs(line);
+        const std::string &cmd = f[0];
+
+        // 只读的重操作：在事件循环中取快照（保证与同一连接前面的写操作有序），交给工作线程执行
+        if (cmd == "LIST" || cmd == "SORTED" || cmd == "SEARCH" ||
+            (cmd == "DEDUP" && f.size() == 1)) {
+            if (cmd == "SEARCH" && (f.size() != 2 || trim_copy(f[1]).empty())) {
+                slot->out = err("用法: SEARCH<TAB>关键词");
+                slot->ready = true;
+                return slot;
+            }
+            const Library::Snapshot snap = lib_.snapshot();
+            const std::string kw = f.size() > 1 ? f[1] : "";
+            submit_read(id, slot, [snap, cmd, kw]() {
+                if (cmd == "LIST")
+                    return ok_songs(collect(snap->items));
+                if (cmd == "SORTED")
+                    return ok_songs(collect(snap->ranked));
+                if (cmd == "DEDUP")
+                    return ok_clusters(find_duplicate_clusters(collect(snap->byId)));
+                return ok_songs(snap->search(kw));
+            });
+            return slot;
+        }
+
+        // 选曲：参数在事件循环中校验，DP 交给工作线程
+        if (cmd == "DJSET" && (f.size() == 3 || f.size() == 4)) {
+            SetRequest req;
+            int tolerance = 0;
+            if (!parse_positive_int(f[1], req.targetSec) || req.targetSec > kMaxTargetSec) {
+                slot->out = err("目标时长需在 1.." + std::to_string(kMaxTargetSec) + " 秒");
+            } else if ((trim_copy(f[2]) != "0" && !parse_positive_int(f[2], tolerance)) ||
+                       tolerance > kMaxTargetSec) {
+                slot->out = err("偏差需在 0.." + std::to_string(kMaxTargetSec) + " 秒");
+            } else {
+                req.toleranceSec = tolerance;
+                req.tag = f.size() == 4 ? trim_copy(f[3]) : "";
+                const Library::Snapshot snap = lib_.snapshot();
+                submit_read(id, slot, [snap, req]() {
+                    DjSet set;
+                    if (!build_dj_set(collect(snap->items), req, set))
+                        return err("无法凑出该时长的歌单");
+                    return ok_songs(set.songs);
+                });
+                return slot;
+            }
+            slot->ready = true;
+            return slot;
+        }
+
+        slot->out = execute_write(f);
+        slot->ready = true;
+        return slot;
+    }
+
+    // 在事件循环线程中执行写操作和轻量的读操作
+    std::string Server::execute_write(const std::vector<std::string> &f) {
+        const std::string &cmd = f[0];
+        int id = 0;
+
+        if (cmd == "PING" && f.size() == 1)
+            return ok_empty();
+
+        if (cmd == "ADD" && f.size() == 5) {
+            int duration = 0;
+            int rating = 0;
+            if (trim_copy(f[1]).empty() || trim_copy(f[2]).empty())
+                return err("标题和艺人不能为空");
+            if (!parse_positive_int(f[3], duration))
+                return err("时长需为正整数");
+            if (!parse_positive_int(f[4], rating) || rating > 5)
+                return err("评分需在 1..5");
+            const Song s(f[1], f[2], duration, rating);
+            lib_.add(s);
+            return ok_song(s);
+        }
+
+        if (cmd == "STATS" && f.size() == 2 && (f[1] == "artist" || f[1] == "tag")) {
+            const LibraryStats stats = lib_.stats();
+            const auto rows = LibraryStats::sorted(f[1] == "artist" ? stats.by_artist() : stats.by_tag());
+            std::ostringstream oss;
+            oss << "OK\t" << rows.size() << "\n";
+            for (const auto &row : rows)
+                oss << LibraryStats::describe(row.first, row.second) << "\n";
+            return oss.str();
+        }
+
+        if (cmd == "SORT" && f.size() == 1) {
+            lib_.sort();
+            return ok_empty();
+        }
+        // 撤销历史是全局的：可能撤销其他连接的修改（见 Server.h 的协议说明）
+        if (cmd == "UNDO" && f.size() == 1)
+            return lib_.undo() ? ok_empty() : err("没有可撤销的操作");
+        if (cmd == "REDO" && f.size() == 1)
+            return lib_.redo() ? ok_empty() : err("没有可重做的操作");
+
+        // 以下命令的第一个参数都是歌曲 id
+        const bool withId = cmd == "GET" || cmd == "DEL" || cmd == "EDIT" || cmd == "TAG+" ||
+                            cmd == "TAG-";
+        if (!withId)
+            return err("未知命令或参数个数不对");
+        if (f.size() < 2 || !parse_positive_int(f[1], id))
+            return err("id 需为正整数");
+
+        const Library::Snapshot snap = lib_.snapshot();
+        const Song *cur = snap->find(id);
+        if (!cur)
+            return err("未找到该 id");
+
+        if (cmd == "GET" && f.size() == 2)
+            return ok_song(*cur);
+
+        if (cmd == "DEL" && f.size() == 2) {
+            const std::string out = ok_song(*cur);
+            lib_.remove(id);
+            return out;
+        }
+
+        if (cmd == "EDIT" && f.size() == 6) {
+            // 先校验全部字段，保证要么全部生效要么都不生效
+            const std::string title = trim_copy(f[2]);
+            const std::string artist = trim_copy(f[3]);
+            int duration = 0;
+            int rating = 0;
+            if (!trim_copy(f[4]).empty() && !parse_positive_int(f[4], duration))
+                return err("时长需为正整数");
+            if (!trim_copy(f[5]).empty() && (!parse_positive_int(f[5], rating) || rating > 5))
+                return err("评分需在 1..5");
+            lib_.update(id, [&](Song &s) {
+                bool changed = false;
+                if (!title.empty())
+                    changed = s.set_title(title) || changed;
+                if (!artist.empty())
+                    changed = s.set_artist(artist) || changed;
+                if (duration > 0)
+                    changed = s.set_duration(duration) || changed;
+                if (rating > 0)
+                    changed = s.set_rating(rating) || changed;
+                return changed;
+            });
+            return ok_song(*lib_.snapshot()->find(id));
+        }
+
+        if ((cmd == "TAG+" || cmd == "TAG-") && f.size() == 3) {
+            const std::string tag = trim_copy(f[2]);
+            if (tag.empty())
+                return err("标签不能为空");
+            if (cmd == "TAG+") {
+                if (cur->has_tag(tag))
+                    return err("标签已存在（忽略大小写）");
+                lib_.update(id, [&](Song &s) { return s.add_tag(tag); });
+            } else {
+                if (!cur->has_tag(tag))
+                    return err("未找到该标签");
+                lib_.update(id, [&](Song &s) { return s.remove_tag(tag); });
+            }
+            return ok_song(*lib_.snapshot()->find(id));
+        }
+
+        return err("未知命令或参数个数不对");
+    }
+}
+
+int run_server(Library &lib, const std::string &path, int workers) {
+    // 在创建工作线程前屏蔽信号，由事件循环通过 signalfd 统一处理
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+    const int sigFd = signalfd(-1, &mask, SFD_CLOEXEC);
+    if (sigFd < 0) {
+        std::perror("signalfd");
+        return 1;
+    }
+
+    int rc = 0;
+    {
+        Server server(lib, std::max(1, workers));
+        rc = server.run(path, sigFd);
+    }
+    close(sigFd);
+    return rc;
+}
@@ -0,0 +1,50 @@
+#pragma once
+/**
+ * @file Server.h
+ * @brief 本地服务模式：在 Unix 域套接字上长期运行，对外提供播放列表操作。
+ *
+ * 协议（UTF-8 文本，一行一个请求，字段以 TAB 分隔，空行忽略）：
+ *
+ *   ADD    title artist duration rating   添加歌曲
+ *   GET    id                             查看歌曲
+ *   LIST                                  按播放列表顺序列出
+ *   SORTED                                按 operator< 顺序列出
+ *   SEARCH keyword                        关键词搜索
+ *   EDIT   id title artist duration rating 修改（字段留空 = 不改）
+ *   TAG+   id tag / TAG- id tag           添加 / 移除标签
+ *   DEL    id                             删除
+ *   STATS  artist|tag                     按艺人 / 标签的聚合统计
+ *   DEDUP                                 近似重复歌曲簇（每行一簇，ID 以空格分隔）
+ *   DJSET  target tolerance [tag]         按目标时长（秒）± 偏差选曲，总评分最大，按 operator< 顺序返回
+ *   SORT / UNDO / REDO / PING              UNDO / REDO 作用于所有客户端共享的同一份历史（见下）
+ *
+ * 每个请求恰好对应一个响应，且按请求顺序返回，因此客户端可以一次发送多个请求（流水线）：
+ *
+ *   OK<TAB>n      后跟 n 行结果（歌曲格式同 Song 的 operator<<，统计格式同 LibraryStats::describe）
+ *   ERR<TAB>消息
+ *
+ * 客户端可以发送完所有请求后半关闭（shutdown(SHUT_WR)），服务端仍会写完全部响应再关闭连接。
+ * 单个请求行最长 64 KiB，超长行回复 ERR；没有换行的超长输入回复 ERR 后丢弃该连接的其余输入。
+ * 撤销历史是全局的，所有连接共享：UNDO 撤销的是整个曲库最近一次修改（ADD / EDIT / TAG+ / TAG- / DEL / SORT），
+ * 不论它来自哪个客户端，服务端也不会通知修改的发起者。需要按客户端隔离撤销时，
+ * 客户端应自行用 EDIT / ADD / DEL 写回旧值，而不是使用 UNDO / REDO。
+ * 撤销历史只保留最近 Library::kDefaultUndoDepth 步（见 Library 的构造函数），
+ * 更早的修改不能再 UNDO，服务长期运行时内存不随写请求数增长。
+ *
+ * 实现：单线程 epoll 事件循环负责网络 I/O 和所有写操作（Library 的唯一写者）；
+ * LIST / SORTED / SEARCH / DEDUP / DJSET 在事件循环中取快照后交给工作线程池执行，结果通过 eventfd 通知回事件循环，
+ * 再按每个连接的请求顺序写回。
+ */
+
+#include "Library.h"
+
+#include <string>
+
+/**
+ * @brief 在 path 上监听并处理请求，直到收到 SIGINT / SIGTERM。
+ * @param lib     要服务的曲库。
+ * @param path    Unix 域套接字路径（已存在的套接字文件会被替换；已存在其他类型的文件时启动失败，不删除它）。
+ * @param workers 搜索工作线程数（>= 1）。
+ * @return 进程退出码：正常退出返回 0，初始化失败返回 1。
+ */
+int run_server(Library &lib, const std::string &path, int workers);
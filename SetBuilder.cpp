@@ -0,0 +1,162 @@
+#include "SetBuilder.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+
+namespace {
+    // 不可达状态；足够小，加上所有评分也不会变成非负，又不会溢出
+    constexpr int kUnreachable = -(1 << 29);
+
+    // 每组选择数记录为 uint16_t，因此每个时长最多考虑这么多首
+    constexpr std::size_t kMaxPerGroup = UINT16_MAX;
+
+    // 回溯表 choice 的单元数上限（约 128 MiB）；只有大量互不相同的超长时长才会触及
+    constexpr std::size_t kMaxChoiceCells = std::size_t{64} << 20;
+
+    bool song_less(const Song *a, const Song *b) {
+        return *a < *b;
+    }
+
+    // 评分/时长比降序（交叉相乘避免浮点），相同时按 operator<
+    bool denser(const Song *a, const Song *b) {
+        const long lhs = static_cast<long>(a->rating()) * b->duration();
+        const long rhs = static_cast<long>(b->rating()) * a->duration();
+        return lhs != rhs ? lhs > rhs : *a < *b;
+    }
+
+    /**
+     * @brief 同一时长的一组歌：songs 按 operator< 排序（即评分降序），
+     * prefix[k] 为前 k 首的评分之和。
+     */
+    struct Group {
+        int duration;
+        std::vector<const Song *> songs;
+        std::vector<int> prefix;
+    };
+}
+
+bool build_dj_set(const std::vector<const Song *> &candidates, const SetRequest &req, DjSet &out) {
+    if (req.targetSec <= 0 || req.targetSec > kMaxTargetSec || req.toleranceSec < 0 ||
+        req.toleranceSec > kMaxTargetSec)
+        return false;
+    const int lo = std::max(0, req.targetSec - req.toleranceSec);
+    int hi = req.targetSec + req.toleranceSec;
+
+    std::vector<const Song *> pool;
+    pool.reserve(candidates.size());
+    long poolTotal = 0;
+    for (const Song *s : candidates) {
+        if (s->duration() <= hi && (req.tag.empty() || s->has_tag(req.tag))) {
+            pool.push_back(s);
+            poolTotal += s->duration();
+        }
+    }
+    // 全部选上也到不了下限；否则 DP 表不必超过候选总时长
+    if (poolTotal < lo)
+        return false;
+    hi = static_cast<int>(std::min<long>(hi, poolTotal));
+
+    // 目标过长：贪心选入高性价比的歌，直到剩余容量落入精确 DP 的跨度
+    std::vector<const Song *> chosen;
+    int used = 0;
+    if (hi > kExactSpanSec) {
+        std::sort(pool.begin(), pool.end(), denser);
+        std::vector<const Song *> rest;
+        rest.reserve(pool.size());
+        for (const Song *s : pool) {
+            if (used + s->duration() <= hi - kExactSpanSec) {
+                chosen.push_back(s);
+                used += s->duration();
+            } else {
+                rest.push_back(s);
+            }
+        }
+        pool.swap(rest);
+    }
+    const int lower = std::max(0, lo - used);
+    const int cap = hi - used;
+
+    // 按时长分组；每组最多用到 cap / duration 首（且不超过 kMaxPerGroup）
+    std::map<int, std::vector<const Song *>> byDuration;
+    for (const Song *s : pool) {
+        if (s->duration() <= cap)
+            byDuration[s->duration()].push_back(s);
+    }
+    std::vector<Group> groups;
+    groups.reserve(byDuration.size());
+    for (auto &entry : byDuration) {
+        Group g{entry.first, std::move(entry.second), {0}};
+        const std::size_t limit =
+            std::min(static_cast<std::size_t>(cap / g.duration), kMaxPerGroup);
+        if (g.songs.size() > limit) {
+            std::partial_sort(g.songs.begin(), g.songs.begin() + limit, g.songs.end(), song_less);
+            g.songs.resize(limit);
+        } else {
+            std::sort(g.songs.begin(), g.songs.end(), song_less);
+        }
+        for (const Song *s : g.songs)
+            g.prefix.push_back(g.prefix.back() + s->rating());
+        groups.push_back(std::move(g));
+    }
+
+    // best[c] = 恰好用去 c 秒时的最大评分；choice[g * width + c] = 第 g 组在该状态下选了几首
+    const std::size_t width = static_cast<std::size_t>(cap) + 1;
+    if (groups.size() > kMaxChoiceCells / width)
+        return false;
+    std::vector<int> best(width, kUnreachable), next(width);
+    std::vector<int> pick(width);
+    std::vector<std::uint16_t> choice(groups.size() * width);
+    best[0] = 0;
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+        const Group &grp = groups[g];
+        std::copy(best.begin(), best.end(), next.begin());
+        std::fill(pick.begin(), pick.end(), 0);
+        const int *src = best.data();
+        int *dst = next.data();
+        int *sel = pick.data();
+        for (std::size_t k = 1; k < grp.prefix.size(); ++k) {
+            const std::size_t offset = k * static_cast<std::size_t>(grp.duration);
+            const int gain = grp.prefix[k];
+            const int kk = static_cast<int>(k);
+            for (std::size_t c = offset; c < width; ++c) {
+                const int candidate = src[c - offset] + gain;
+                const bool better = candidate > dst[c];
+                dst[c] = better ? candidate : dst[c];
+                sel[c] = better ? kk : sel[c];
+            }
+        }
+        std::copy(pick.begin(), pick.end(), choice.begin() + g * width);
+        best.swap(next);
+    }
+
+    // 在窗口内取评分最大、其次离目标最近的状态；窗口下限 <= 0 时也不接受空歌单（c = 0 且未贪心选歌）
+    int bestC = -1;
+    for (int c = std::max(lower, used > 0 ? 0 : 1); c <= cap; ++c) {
+        if (best[c] < 0)
+            continue;
+        if (bestC < 0 || best[c] > best[bestC] ||
+            (best[c] == best[bestC] &&
+             std::abs(c + used - req.targetSec) < std::abs(bestC + used - req.targetSec)))
+            bestC = c;
+    }
+    if (bestC < 0)
+        return false;
+
+    for (std::size_t g = groups.size(), c = static_cast<std::size_t>(bestC); g-- > 0;) {
+        const std::size_t k = choice[g * width + c];
+        chosen.insert(chosen.end(), groups[g].songs.begin(), groups[g].songs.begin() + k);
+        c -= k * static_cast<std::size_t>(groups[g].duration);
+    }
+
+    std::sort(chosen.begin(), chosen.end(), song_less);
+    out.songs = std::move(chosen);
+    out.totalDuration = 0;
+    out.totalRating = 0;
+    for (const Song *s : out.songs) {
+        out.totalDuration += s->duration();
+        out.totalRating += s->rating();
+    }
+    return true;
+}
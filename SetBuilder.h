@@ -0,0 +1,59 @@
+#pragma once
+/**
+ * @file SetBuilder.h
+ * @brief 按目标时长选曲：在时长窗口 [目标 - 容差, 目标 + 容差] 内使总评分最大。
+ *
+ * 这是一个 0/1 背包问题（容量 = 秒数，价值 = 评分），按时长分组后求解：
+ * 时长相同的歌曲里，选 k 首时一定选评分最高的 k 首（operator< 顺序的前 k 首），
+ * 因此每个时长只需决定选几首（上限 min(该组首数, 上界 / 时长)），
+ * 每组一遍对整张 DP 表的连续扫描（比较 + 选择，可被编译器向量化），记录每组的选择数用于回溯。
+ *
+ * 目标超过 kExactSpanSec 时，先按评分/时长比贪心选入歌曲，
+ * 只把最后 kExactSpanSec 秒留给精确 DP（近似解，但仍保证总时长落在窗口内）。
+ */
+
+#include "Song.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief 选曲条件。
+ */
+struct SetRequest {
+    int targetSec = 3600;  // 目标时长（秒）
+    int toleranceSec = 30; // 允许偏差（秒）
+    std::string tag;       // 只从带该标签的歌曲中选（见 Song::has_tag）；为空表示不限
+};
+
+/**
+ * @brief 选曲结果。
+ */
+struct DjSet {
+    std::vector<const Song *> songs; // 按 operator< 顺序
+    int totalDuration = 0;
+    int totalRating = 0;
+};
+
+/**
+ * @brief 精确 DP 覆盖的最大时长跨度（秒）；目标更长时前面的部分用贪心填充。
+ */
+constexpr int kExactSpanSec = 2 * 3600;
+
+/**
+ * @brief 目标时长和允许偏差的上限（秒）；超过时 build_dj_set 直接返回 false。
+ */
+constexpr int kMaxTargetSec = 24 * 3600;
+
+/**
+ * @brief 从候选歌曲中选出总时长落在窗口内、总评分最大的一组歌。
+ * 评分相同时取总时长最接近目标的组合。
+ * @param candidates 候选歌曲（指针在调用期间须保持有效）。
+ * @param req        选曲条件。
+ * @param out        成功时写入结果。
+ * DP 表的宽度不超过 min(目标 + 偏差, 候选总时长)，候选总时长不足窗口下限时直接返回 false。
+ * @return 找到满足时长窗口、且至少包含一首歌的组合返回 true；否则返回 false，out 不变
+ *         （目标 <= 偏差时空歌单也落在窗口内，但不算找到）。
+ *         目标或偏差超过 kMaxTargetSec、或回溯表超过内存上限（大量互不相同的超长时长）时也返回 false。
+ */
+bool build_dj_set(const std::vector<const Song *> &candidates, const SetRequest &req, DjSet &out);
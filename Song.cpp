@@ -25,6 +25,38 @@ namespace {
         return result;
     }
 
+    // 与 "C" locale 下的 ::tolower 等价，但可内联
+    inline char ascii_lower(char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    // 逐字节忽略大小写比较两个字符串是否相等，不分配内存
+    bool equals_ignore_case(const std::string &a, const std::string &b) {
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (ascii_lower(a[i]) != ascii_lower(b[i]))
+                return false;
+        }
+        return true;
+    }
+
+    // 判断 text 是否包含 lowerKw（lowerKw 已转为小写），逐字节忽略大小写比较，不分配内存
+    bool contains_ignore_case(const std::string &text, const std::string &lowerKw) {
+        if (lowerKw.size() > text.size())
+            return false;
+        const size_t last = text.size() - lowerKw.size();
+        for (size_t i = 0; i <= last; ++i) {
+            size_t j = 0;
+            while (j < lowerKw.size() && ascii_lower(text[i + j]) == lowerKw[j]) {
+                ++j;
+            }
+            if (j == lowerKw.size())
+                return true;
+        }
+        return false;
+    }
+
     std::string join_tags(const std::vector<std::string> &tags) {
         if (tags.empty())
             return "";
@@ -123,12 +155,9 @@ bool Song::add_tag(const std::string &tag) {
         std::cout << "[提示] 空标签已忽略\n";
         return false;
     }
-    std::string lower_t = to_lower_copy(t);
-    for (const auto &existing : tags_) {
-        if (to_lower_copy(existing) == lower_t) {
-            std::cout << "[提示] 标签已存在（忽略大小写）\n";
-            return false;
-        }
+    if (has_tag(t)) {
+        std::cout << "[提示] 标签已存在（忽略大小写）\n";
+        return false;
     }
     tags_.push_back(t);
     return true;
@@ -137,9 +166,8 @@ bool Song::add_tag(const std::string &tag) {
 
 bool Song::remove_tag(const std::string &tag) {
     std::string t = trim_copy(tag);
-    std::string lower_t = to_lower_copy(t);
     for (size_t i = 0; i < tags_.size(); ++i) {
-        if (to_lower_copy(tags_[i]) == lower_t) {
+        if (equals_ignore_case(tags_[i], t)) {
             tags_.erase(tags_.begin() + static_cast<std::ptrdiff_t>(i));
             return true;
         }
@@ -148,6 +176,15 @@ bool Song::remove_tag(const std::string &tag) {
     return false;
 }
 
+bool Song::has_tag(const std::string &tag) const {
+    const std::string t = trim_copy(tag);
+    for (const auto &existing : tags_) {
+        if (equals_ignore_case(existing, t))
+            return true;
+    }
+    return false;
+}
+
 // --- 功能函数 ---
 
 bool Song::matches_keyword(const std::string &kw) const {
@@ -155,12 +192,12 @@ bool Song::matches_keyword(const std::string &kw) const {
     if (k.empty())
         return false;
 
-    if (to_lower_copy(title_).find(k) != std::string::npos)
+    if (contains_ignore_case(title_, k))
         return true;
-    if (to_lower_copy(artist_).find(k) != std::string::npos)
+    if (contains_ignore_case(artist_, k))
         return true;
     for (const auto &tg : tags_) {
-        if (to_lower_copy(tg).find(k) != std::string::npos)
+        if (contains_ignore_case(tg, k))
             return true;
     }
     return false;
@@ -0,0 +1,110 @@
+#include "Stats.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    std::string to_lower_copy(const std::string &s) {
+        std::string result = s;
+        std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+        return result;
+    }
+
+    std::vector<std::string> lower_tags(const Song &s) {
+        std::vector<std::string> tags;
+        tags.reserve(s.tags().size());
+        for (const auto &t : s.tags())
+            tags.push_back(to_lower_copy(t));
+        return tags;
+    }
+
+    bool contains(const std::vector<std::string> &v, const std::string &x) {
+        return std::find(v.begin(), v.end(), x) != v.end();
+    }
+
+    // sign = +1 加入一首歌的贡献，-1 移除
+    void apply(LibraryStats::Table &table, const std::string &key, const Song &s, int sign) {
+        StatsBucket &b = table[key];
+        b.count += sign;
+        b.totalDuration += sign * s.duration();
+        b.ratingHist[s.rating() - 1] += sign;
+        if (b.count == 0)
+            table.erase(key);
+    }
+
+    // 同一个桶中，一首歌由 before 变为 after：只修正时长和评分分布
+    void adjust(LibraryStats::Table &table, const std::string &key, const Song &before,
+                const Song &after) {
+        StatsBucket &b = table[key];
+        b.totalDuration += after.duration() - before.duration();
+        b.ratingHist[before.rating() - 1] -= 1;
+        b.ratingHist[after.rating() - 1] += 1;
+    }
+}
+
+double StatsBucket::average_rating() const {
+    if (count == 0)
+        return 0.0;
+    long sum = 0;
+    for (int r = 1; r <= 5; ++r)
+        sum += r * ratingHist[r - 1];
+    return static_cast<double>(sum) / static_cast<double>(count);
+}
+
+void LibraryStats::on_added(const Song &s) {
+    apply(byArtist_, s.artist(), s, +1);
+    for (const auto &t : lower_tags(s))
+        apply(byTag_, t, s, +1);
+}
+
+void LibraryStats::on_removed(const Song &s) {
+    apply(byArtist_, s.artist(), s, -1);
+    for (const auto &t : lower_tags(s))
+        apply(byTag_, t, s, -1);
+}
+
+void LibraryStats::on_updated(const Song &before, const Song &after) {
+    const bool valuesChanged =
+        before.duration() != after.duration() || before.rating() != after.rating();
+
+    // 艺人
+    if (before.artist() != after.artist()) {
+        apply(byArtist_, before.artist(), before, -1);
+        apply(byArtist_, after.artist(), after, +1);
+    } else if (valuesChanged) {
+        adjust(byArtist_, after.artist(), before, after);
+    }
+
+    // 标签：移除的、保留的、新增的分别处理
+    const std::vector<std::string> oldTags = lower_tags(before);
+    const std::vector<std::string> newTags = lower_tags(after);
+    for (const auto &t : oldTags) {
+        if (!contains(newTags, t))
+            apply(byTag_, t, before, -1);
+        else if (valuesChanged)
+            adjust(byTag_, t, before, after);
+    }
+    for (const auto &t : newTags) {
+        if (!contains(oldTags, t))
+            apply(byTag_, t, after, +1);
+    }
+}
+
+std::string LibraryStats::describe(const std::string &name, const StatsBucket &b) {
+    std::ostringstream oss;
+    oss << name << ": " << b.count << " 首, 总时长 " << b.totalDuration << "s, 平均评分 "
+        << std::fixed << std::setprecision(2) << b.average_rating() << ", 评分分布 [";
+    for (int r = 0; r < 5; ++r)
+        oss << (r ? " " : "") << b.ratingHist[r];
+    oss << "]";
+    return oss.str();
+}
+
+std::vector<std::pair<std::string, StatsBucket>> LibraryStats::sorted(const Table &table) {
+    std::vector<std::pair<std::string, StatsBucket>> rows(table.begin(), table.end());
+    std::sort(rows.begin(), rows.end(),
+              [](const std::pair<std::string, StatsBucket> &a,
+                 const std::pair<std::string, StatsBucket> &b) { return a.first < b.first; });
+    return rows;
+}
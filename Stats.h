@@ -0,0 +1,69 @@
+#pragma once
+/**
+ * @file Stats.h
+ * @brief 按艺人、按标签增量维护的聚合统计（歌曲数、总时长、评分分布）。
+ *
+ * 每次修改只触及受影响的桶：添加/删除一首歌更新其艺人桶和各标签桶；
+ * 修改时按字段比较新旧版本，只有变化的字段（艺人、时长、评分、增删的标签）才调整对应的桶。
+ * 标签按小写归并（与 Song::add_tag 的忽略大小写查重一致）。
+ */
+
+#include "Song.h"
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 一个艺人或一个标签的聚合值。
+ */
+struct StatsBucket {
+    long count = 0;            // 歌曲数
+    long totalDuration = 0;    // 总时长（秒）
+    long ratingHist[5] = {};   // ratingHist[r - 1] 为评分 r 的歌曲数
+
+    /**
+     * @brief 平均评分；桶为空时返回 0。
+     */
+    double average_rating() const;
+};
+
+class LibraryStats {
+  public:
+    using Table = std::unordered_map<std::string, StatsBucket>;
+
+    const Table &by_artist() const { return byArtist_; }
+    const Table &by_tag() const { return byTag_; }
+
+    /**
+     * @brief 一首歌被加入曲库。
+     */
+    void on_added(const Song &s);
+
+    /**
+     * @brief 一首歌被移出曲库。
+     */
+    void on_removed(const Song &s);
+
+    /**
+     * @brief 一首歌从 before 修改为 after（ID 相同）。
+     * 只调整变化涉及的桶：艺人不变时原地修正时长/评分，艺人改变时在两个桶之间迁移，
+     * 标签按新旧集合的差异增删。
+     */
+    void on_updated(const Song &before, const Song &after);
+
+    /**
+     * @brief 按名称排序的 (名称, 桶) 列表，用于输出。
+     */
+    static std::vector<std::pair<std::string, StatsBucket>> sorted(const Table &table);
+
+    /**
+     * @brief 格式化一行统计，例如 "周杰伦: 2 首, 总时长 436s, 平均评分 4.50, 评分分布 [0 0 0 1 1]"。
+     */
+    static std::string describe(const std::string &name, const StatsBucket &b);
+
+  private:
+    Table byArtist_;
+    Table byTag_;
+};
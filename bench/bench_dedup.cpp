@@ -0,0 +1,222 @@
+/**
+ * @file bench_dedup.cpp
+ * @brief 百万级曲库查重耗时、召回率与精确率基准。
+ *
+ * 生成 1M 首歌（约 2 万个艺人、随机中英文标题），每首歌属于一个“作品”：
+ * - 约 17% 是前面某首歌的变体（同一作品），分两类：
+ *   归一化后与原曲完全相同的（"(Live)"、"【Remix】"、大小写、空白、全角括号、标点），
+ *   以及只能靠 MinHash/LSH 找到的近似变体（拼写错误、删掉或多出一个单词）；
+ * - 约 8% 是前面某首歌的编号续作（原标题 + " No. k"，不同作品），用来检验误合并。
+ * 对 1/2/4/8 个线程分别计时；然后按变体类型统计召回率（变体与原曲落在同一簇的比例），
+ * 并按簇内歌曲对统计精确率（同簇的歌曲对中属于同一作品的比例）。
+ */
+
+#include "Dedup.h"
+#include "Song.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    const char *const kHan[] = {"告", "白", "气", "球", "稻", "香", "晴", "天", "夜", "曲",
+                                "爱", "在", "西", "元", "前", "海", "阔", "空", "光", "年",
+                                "红", "豆", "风", "雨", "花", "火", "星", "河", "梦", "远"};
+    const char *const kWord[] = {"love",   "night",  "shape",  "you",    "dance",  "heart",
+                                 "fire",   "dream",  "blue",   "rain",   "city",   "light",
+                                 "home",   "road",   "summer", "river",  "golden", "silent",
+                                 "wild",   "forever", "morning", "echo",  "paper",  "stone",
+                                 "ocean",  "winter", "broken", "little", "sky",    "memory"};
+    const int kHanCount = sizeof(kHan) / sizeof(kHan[0]);
+    const int kWordCount = sizeof(kWord) / sizeof(kWord[0]);
+
+    enum Kind {
+        kLive, kRemix, kSpaces, kAcoustic, kUpper, kPunct, // 归一化后与原曲相同
+        kTypo, kDropWord, kAddWord,                         // 只能靠相似度找到
+        kKinds
+    };
+    const char *const kKindName[] = {"(Live)", "【Remix】", "spaces", "（Acoustic）", "upper case",
+                                     "punct",  "typo",     "drop word", "add word"};
+
+    std::string random_title(std::mt19937 &rng) {
+        std::string t;
+        if (rng() % 2) {
+            const int len = 3 + static_cast<int>(rng() % 4);
+            for (int i = 0; i < len; ++i)
+                t += kHan[rng() % kHanCount];
+        } else {
+            const int len = 2 + static_cast<int>(rng() % 5);
+            for (int i = 0; i < len; ++i)
+                t += std::string(i ? " " : "") + kWord[rng() % kWordCount];
+        }
+        return t;
+    }
+
+    bool is_latin(const std::string &t) {
+        return !t.empty() && static_cast<unsigned char>(t[0]) < 0x80;
+    }
+
+    int word_count(const std::string &t) {
+        return static_cast<int>(std::count(t.begin(), t.end(), ' ')) + 1;
+    }
+
+    // 按 kind 生成变体；该类型不适用于此标题时返回空串
+    std::string variant_of(const std::string &title, Kind kind, std::mt19937 &rng) {
+        switch (kind) {
+        case kLive: return title + " (Live)";
+        case kRemix: return title + "【Remix】";
+        case kSpaces: return "  " + title + "  ";
+        case kAcoustic: return title + " （Acoustic）";
+        case kUpper: {
+            std::string upper = title;
+            std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+            return upper;
+        }
+        case kPunct: return title + "!";
+        case kTypo: {
+            if (!is_latin(title) || title.size() < 12)
+                return "";
+            std::string typo = title;
+            std::size_t pos = 1 + rng() % (typo.size() - 2);
+            while (typo[pos] == ' ')
+                pos = 1 + rng() % (typo.size() - 2);
+            typo[pos] = typo[pos] == 'x' ? 'z' : 'x';
+            return typo;
+        }
+        case kDropWord:
+            if (!is_latin(title) || word_count(title) < 4)
+                return "";
+            return title.substr(0, title.rfind(' '));
+        case kAddWord:
+            if (!is_latin(title) || word_count(title) < 4)
+                return "";
+            return title + " " + kWord[rng() % kWordCount];
+        default: return "";
+        }
+    }
+
+    long pairs(long k) {
+        return k * (k - 1) / 2;
+    }
+}
+
+int main() {
+    const int n = 1000000;
+    std::mt19937 rng(42);
+    std::vector<Song> songs;
+    std::vector<int> work;       // songs[i] 所属作品
+    std::vector<bool> isSequel;  // 续作不再派生变体（否则删词、拼错可能恰好去掉编号）
+    songs.reserve(n);
+    work.reserve(n);
+    isSequel.reserve(n);
+    struct Injected {
+        int orig, variant;
+        Kind kind;
+    };
+    std::vector<Injected> injected;
+    std::vector<std::pair<int, int>> sequels; // (原曲 ID, 续作 ID)
+    std::map<int, int> nextNumber;            // 作品 -> 下一个续作编号（各版本共用）
+    int works = 0;
+
+    while (static_cast<int>(songs.size()) < n) {
+        const int roll = static_cast<int>(rng() % 100);
+        if (!songs.empty() && roll < 17) {
+            const std::size_t o = rng() % songs.size();
+            if (isSequel[o])
+                continue;
+            const Kind kind = static_cast<Kind>(rng() % kKinds);
+            const std::string title = variant_of(songs[o].title(), kind, rng);
+            if (title.empty())
+                continue;
+            songs.emplace_back(title, songs[o].artist(), songs[o].duration() + 3,
+                               songs[o].rating());
+            work.push_back(work[o]);
+            isSequel.push_back(false);
+            injected.push_back({songs[o].id(), songs.back().id(), kind});
+        } else if (!songs.empty() && roll < 25) {
+            const std::size_t o = rng() % songs.size();
+            const int number = ++nextNumber[work[o]];
+            songs.emplace_back(songs[o].title() + " No. " + std::to_string(number),
+                               songs[o].artist(), songs[o].duration(), songs[o].rating());
+            work.push_back(works++);
+            isSequel.push_back(true);
+            sequels.emplace_back(songs[o].id(), songs.back().id());
+        } else {
+            songs.emplace_back(random_title(rng), "artist " + std::to_string(rng() % 20000),
+                               120 + static_cast<int>(rng() % 300),
+                               1 + static_cast<int>(rng() % 5));
+            work.push_back(works++);
+            isSequel.push_back(false);
+        }
+    }
+    std::vector<const Song *> ptrs;
+    ptrs.reserve(n);
+    std::unordered_map<int, int> workOf; // ID -> 作品
+    for (std::size_t i = 0; i < songs.size(); ++i) {
+        ptrs.push_back(&songs[i]);
+        workOf[songs[i].id()] = work[i];
+    }
+
+    std::printf("hardware threads: %u, songs: %d, injected variants: %zu, numbered sequels: %zu\n",
+                std::thread::hardware_concurrency(), n, injected.size(), sequels.size());
+    std::printf("%8s %10s %10s %12s\n", "threads", "ms", "clusters", "in clusters");
+    std::vector<std::vector<int>> clusters;
+    for (int threads : {1, 2, 4, 8}) {
+        const auto start = Clock::now();
+        clusters = find_duplicate_clusters(ptrs, threads);
+        const double ms =
+            std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        std::size_t members = 0;
+        for (const auto &c : clusters)
+            members += c.size();
+        std::printf("%8d %10.0f %10zu %12zu\n", threads, ms, clusters.size(), members);
+    }
+
+    // 召回率：按变体类型
+    std::unordered_map<int, std::size_t> clusterOf;
+    for (std::size_t c = 0; c < clusters.size(); ++c)
+        for (int id : clusters[c])
+            clusterOf[id] = c;
+    auto together = [&](int a, int b) {
+        auto x = clusterOf.find(a), y = clusterOf.find(b);
+        return x != clusterOf.end() && y != clusterOf.end() && x->second == y->second;
+    };
+    long total[kKinds] = {}, found[kKinds] = {};
+    for (const Injected &v : injected) {
+        ++total[v.kind];
+        found[v.kind] += together(v.orig, v.variant);
+    }
+    std::printf("\n%-14s %9s %8s\n", "variant", "count", "recall");
+    for (int k = 0; k < kKinds; ++k)
+        std::printf("%-14s %9ld %7.1f%%\n", kKindName[k], total[k],
+                    100.0 * static_cast<double>(found[k]) / static_cast<double>(total[k]));
+
+    // 精确率：同簇歌曲对中属于同一作品的比例；另统计被误合并的编号续作
+    long reported = 0, correct = 0;
+    for (const auto &c : clusters) {
+        std::unordered_map<int, long> perWork;
+        for (int id : c)
+            ++perWork[workOf[id]];
+        reported += pairs(static_cast<long>(c.size()));
+        for (const auto &w : perWork)
+            correct += pairs(w.second);
+    }
+    long sequelMerged = 0;
+    for (const auto &s : sequels)
+        sequelMerged += together(s.first, s.second);
+    std::printf("\npair precision: %.2f%% (%ld of %ld pairs)\n",
+                100.0 * static_cast<double>(correct) / static_cast<double>(reported), correct,
+                reported);
+    std::printf("numbered sequels merged with original: %ld of %zu\n", sequelMerged,
+                sequels.size());
+    return 0;
+}
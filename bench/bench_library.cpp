@@ -0,0 +1,98 @@
+/**
+ * @file bench_library.cpp
+ * @brief Library 读吞吐量随读者线程数的扩展性基准。
+ *
+ * 曲库预置 100k 首歌，一个写者线程持续修改评分，同时 1/2/4/8 个读者线程各运行固定时长：
+ * - top10：取快照并按 ranked 顺序读取前 10 首（排序列表的典型请求）；
+ * - search：取快照并做一次全表关键词搜索。
+ * 读者不获取写锁，只在取快照时短暂持有 shared_ptr atomic_load 的内部锁（libstdc++ 中并非无锁），
+ * 总吞吐量应随线程数（在可用核数内）近似线性增长；top10 请求很短，取快照的开销占比最大。
+ */
+
+#include "Library.h"
+#include "Song.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Result {
+        double readsPerSec;
+        double writesPerSec;
+    };
+
+    template <typename F>
+    Result run(Library &lib, int readers, int seconds, F readOnce) {
+        std::atomic<bool> stop{false};
+        std::atomic<long> reads{0};
+        long writes = 0;
+
+        std::thread writer([&]() {
+            const Library::Snapshot snap = lib.snapshot();
+            const std::size_t n = snap->items.size();
+            for (std::size_t i = 0; !stop.load(); ++i) {
+                const int id = snap->items.at((i * 7919) % n).id();
+                const int rating = 1 + static_cast<int>(i % 5);
+                lib.update(id, [&](Song &s) { return s.set_rating(rating); });
+                ++writes;
+            }
+        });
+
+        std::vector<std::thread> pool;
+        for (int r = 0; r < readers; ++r) {
+            pool.emplace_back([&]() {
+                long local = 0;
+                while (!stop.load()) {
+                    readOnce(*lib.snapshot());
+                    ++local;
+                }
+                reads += local;
+            });
+        }
+
+        std::this_thread::sleep_for(std::chrono::seconds(seconds));
+        stop = true;
+        for (auto &t : pool)
+            t.join();
+        writer.join();
+        return {static_cast<double>(reads.load()) / seconds, static_cast<double>(writes) / seconds};
+    }
+}
+
+int main() {
+    Library lib;
+    for (int i = 0; i < 100000; ++i) {
+        Song s("title " + std::to_string(i), "artist " + std::to_string(i % 997), 120 + i % 300,
+               1 + i % 5);
+        if (i % 10 == 0)
+            s.add_tag("rock");
+        lib.add(s);
+    }
+
+    std::atomic<long> sink{0};
+    auto top10 = [&](const LibrarySnapshot &snap) {
+        long sum = 0;
+        for (std::size_t i = 0; i < 10 && i < snap.ranked.size(); ++i)
+            sum += snap.ranked.at(i).id();
+        sink += sum;
+    };
+    auto search = [&](const LibrarySnapshot &snap) {
+        sink += static_cast<long>(snap.search("rock").size());
+    };
+
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    std::printf("%8s %16s %16s %16s\n", "readers", "top10 reads/s", "search reads/s", "writes/s");
+    for (int readers : {1, 2, 4, 8}) {
+        const Result a = run(lib, readers, 1, top10);
+        const Result b = run(lib, readers, 1, search);
+        std::printf("%8d %16.0f %16.1f %16.0f\n", readers, a.readsPerSec, b.readsPerSec,
+                    (a.writesPerSec + b.writesPerSec) / 2);
+    }
+    return sink.load() == -1 ? 1 : 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file bench_setbuilder.cpp
+ * @brief 选曲耗时基准：1k / 10k / 100k 首候选歌曲，目标 1 小时 ±30 秒。
+ *
+ * 候选歌曲时长在 [90, 480) 秒、评分 1..5 随机，10% 带 "rock" 标签。
+ * 每种规模分别测不限标签和限定 "rock" 两种请求；最后一行是 6 小时目标，走贪心 + DP 的近似路径。
+ */
+
+#include "SetBuilder.h"
+#include "Song.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    void run(const char *label, const std::vector<const Song *> &candidates, const SetRequest &req) {
+        const int rounds = 5;
+        DjSet set;
+        bool found = false;
+        const auto start = Clock::now();
+        for (int i = 0; i < rounds; ++i)
+            found = build_dj_set(candidates, req, set);
+        const double ms =
+            std::chrono::duration<double, std::milli>(Clock::now() - start).count() / rounds;
+        if (!found) {
+            std::printf("%-22s %9zu %10.2f %8s\n", label, candidates.size(), ms, "-");
+            return;
+        }
+        std::printf("%-22s %9zu %10.2f %8zu %10d %8d\n", label, candidates.size(), ms,
+                    set.songs.size(), set.totalDuration, set.totalRating);
+    }
+}
+
+int main() {
+    std::mt19937 rng(7);
+    std::vector<Song> songs;
+    songs.reserve(100000);
+    for (int i = 0; i < 100000; ++i) {
+        songs.emplace_back("title " + std::to_string(i), "artist " + std::to_string(i % 997),
+                           90 + static_cast<int>(rng() % 390), 1 + static_cast<int>(rng() % 5));
+        if (rng() % 10 == 0)
+            songs.back().add_tag("rock");
+    }
+
+    SetRequest hour;
+    SetRequest rock;
+    rock.tag = "rock";
+    SetRequest sixHours;
+    sixHours.targetSec = 6 * 3600;
+
+    std::printf("%-22s %9s %10s %8s %10s %8s\n", "request", "songs", "ms", "chosen", "duration",
+                "rating");
+    for (std::size_t n : {1000u, 10000u, 100000u}) {
+        std::vector<const Song *> candidates;
+        for (std::size_t i = 0; i < n; ++i)
+            candidates.push_back(&songs[i]);
+        run("1h +-30s", candidates, hour);
+        run("1h +-30s tag=rock", candidates, rock);
+        if (n == 100000u)
+            run("6h +-30s (greedy+DP)", candidates, sixHours);
+    }
+    return 0;
+}
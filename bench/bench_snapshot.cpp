@@ -0,0 +1,84 @@
+/**
+ * @file bench_snapshot.cpp
+ * @brief 快照/撤销开销的基准测试。
+ *
+ * 对不同规模的播放列表，测量：
+ * - snapshot：复制一个 Playlist（撤销历史保存的就是它）；
+ * - edit+commit：修改一首歌并提交到 History（O(log n) 路径复制）；
+ * - vector copy：作为对照，复制整个 vector<Song> 的代价。
+ *
+ * 期望结果：snapshot 与规模无关，edit+commit 随 log n 缓慢增长，vector copy 随 n 线性增长。
+ */
+
+#include "History.h"
+#include "Playlist.h"
+#include "Song.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double ns_since(Clock::time_point start, long iterations) {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+        return static_cast<double>(ns.count()) / static_cast<double>(iterations);
+    }
+
+    std::vector<Song> make_songs(int n) {
+        std::vector<Song> songs;
+        songs.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            songs.emplace_back("title " + std::to_string(i), "artist " + std::to_string(i % 997),
+                               120 + i % 300, 1 + i % 5);
+        }
+        return songs;
+    }
+}
+
+int main() {
+    std::printf("%10s %16s %18s %18s\n", "songs", "snapshot(ns)", "edit+commit(ns)", "vector copy(ns)");
+
+    for (int n : {1000, 10000, 100000, 1000000}) {
+        const std::vector<Song> songs = make_songs(n);
+        const Playlist base(songs);
+
+        // 1. 拍快照：复制 Playlist
+        const long snapIters = 1000000;
+        std::size_t sink = 0;
+        auto start = Clock::now();
+        for (long i = 0; i < snapIters; ++i) {
+            Playlist snap = base;
+            sink += snap.size();
+        }
+        const double snapNs = ns_since(start, snapIters);
+
+        // 2. 修改一首歌并提交到撤销历史
+        History<Playlist> hist(base);
+        const long editIters = 10000;
+        start = Clock::now();
+        for (long i = 0; i < editIters; ++i) {
+            const std::size_t idx = static_cast<std::size_t>(i * 7919) % static_cast<std::size_t>(n);
+            Song s = hist.current().at(idx);
+            s.set_rating(1 + static_cast<int>(i % 5));
+            hist.commit(hist.current().set(idx, s));
+        }
+        const double editNs = ns_since(start, editIters);
+
+        // 3. 对照：整表复制
+        const long copyIters = n >= 100000 ? 5 : 100;
+        start = Clock::now();
+        for (long i = 0; i < copyIters; ++i) {
+            std::vector<Song> copy = songs;
+            sink += copy.size();
+        }
+        const double copyNs = ns_since(start, copyIters);
+
+        std::printf("%10d %16.1f %18.1f %18.0f\n", n, snapNs, editNs, copyNs);
+        if (sink == 0)
+            std::printf("\n");
+    }
+    return 0;
+}
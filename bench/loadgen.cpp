@@ -0,0 +1,310 @@
+/**
+ * @file loadgen.cpp
+ * @brief 服务模式的本地压测工具（见 Server.h 中的协议说明）。
+ *
+ * 压测模式：
+ *   loadgen <套接字> [连接数=4] [流水线深度=32] [请求总数=200000] [预置歌曲数=10000]
+ *   先通过一个连接预置歌曲，然后每个连接一次发送“深度”个请求、再读回全部响应，
+ *   请求混合为 70% GET、15% EDIT（改评分）、10% SEARCH、5% TAG+。
+ *   输出吞吐量（请求/秒）和延迟分位数（从整批发出到该请求的响应读完），
+ *   以及压测前后服务端进程的常驻内存（通过 SO_PEERCRED 取得服务端 PID，读取 /proc/<pid>/status），
+ *   用于确认长期运行时内存不随写请求增长。
+ *
+ * 回放模式：
+ *   loadgen <套接字> --replay < 请求文件
+ *   把标准输入中的全部请求一次性写入（流水线），按顺序把响应原样打印到标准输出。
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    int connect_to(const std::string &path) {
+        const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (fd < 0 || path.size() >= sizeof(addr.sun_path))
+            return -1;
+        std::copy(path.begin(), path.end(), addr.sun_path);
+        // 服务端可能还在启动，短暂重试
+        for (int attempt = 0; attempt < 100; ++attempt) {
+            if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0)
+                return fd;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        close(fd);
+        return -1;
+    }
+
+    // 套接字对端进程的 PID；取不到时返回 -1
+    long peer_pid(int fd) {
+        ucred cred{};
+        socklen_t len = sizeof(cred);
+        if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0)
+            return -1;
+        return cred.pid;
+    }
+
+    // 进程的常驻内存（kB）；取不到时返回 -1
+    long rss_kb(long pid) {
+        std::ifstream status("/proc/" + std::to_string(pid) + "/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, 6, "VmRSS:") == 0)
+                return std::atol(line.c_str() + 6);
+        }
+        return -1;
+    }
+
+    bool send_all(int fd, const std::string &data) {
+        std::size_t off = 0;
+        while (off < data.size()) {
+            const ssize_t n = send(fd, data.data() + off, data.size() - off, MSG_NOSIGNAL);
+            if (n <= 0)
+                return false;
+            off += static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+    /**
+     * @brief 带缓冲的按行读取。
+     */
+    class LineReader {
+      public:
+        explicit LineReader(int fd) : fd_(fd) {}
+
+        bool read_line(std::string &line) {
+            for (;;) {
+                const std::size_t nl = buf_.find('\n', pos_);
+                if (nl != std::string::npos) {
+                    line.assign(buf_, pos_, nl - pos_);
+                    pos_ = nl + 1;
+                    return true;
+                }
+                buf_.erase(0, pos_);
+                pos_ = 0;
+                char chunk[64 * 1024];
+                const ssize_t n = read(fd_, chunk, sizeof(chunk));
+                if (n <= 0)
+                    return false;
+                buf_.append(chunk, static_cast<std::size_t>(n));
+            }
+        }
+
+        // 读取一个完整响应（头部 + n 行歌曲），返回头部以外的行
+        bool read_response(std::string &header, std::vector<std::string> *lines) {
+            if (!read_line(header))
+                return false;
+            if (header.compare(0, 3, "OK\t") != 0)
+                return true;
+            const long n = std::atol(header.c_str() + 3);
+            std::string line;
+            for (long i = 0; i < n; ++i) {
+                if (!read_line(line))
+                    return false;
+                if (lines)
+                    lines->push_back(line);
+            }
+            return true;
+        }
+
+      private:
+        int fd_;
+        std::string buf_;
+        std::size_t pos_ = 0;
+    };
+
+    int replay(const std::string &path) {
+        std::string requests;
+        std::string line;
+        int count = 0;
+        while (std::getline(std::cin, line)) {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (line.empty())
+                continue;
+            requests += line + "\n";
+            ++count;
+        }
+
+        const int fd = connect_to(path);
+        if (fd < 0 || !send_all(fd, requests)) {
+            std::cerr << "无法连接 " << path << "\n";
+            return 1;
+        }
+        LineReader reader(fd);
+        std::string header;
+        for (int i = 0; i < count; ++i) {
+            std::vector<std::string> lines;
+            if (!reader.read_response(header, &lines)) {
+                std::cerr << "连接意外断开\n";
+                return 1;
+            }
+            std::cout << header << "\n";
+            for (const auto &l : lines)
+                std::cout << l << "\n";
+        }
+        close(fd);
+        return 0;
+    }
+
+    // 从 ADD 的响应行 "[#id] ..." 中取出 id
+    int parse_id(const std::string &songLine) {
+        return std::atoi(songLine.c_str() + 2);
+    }
+
+    std::string make_request(std::mt19937 &rng, const std::vector<int> &ids) {
+        const int id = ids[rng() % ids.size()];
+        const int roll = static_cast<int>(rng() % 100);
+        if (roll < 70)
+            return "GET\t" + std::to_string(id) + "\n";
+        if (roll < 85)
+            return "EDIT\t" + std::to_string(id) + "\t\t\t\t" + std::to_string(1 + rng() % 5) + "\n";
+        if (roll < 95)
+            return "SEARCH\ttitle " + std::to_string(rng() % 1000) + "\n";
+        return "TAG+\t" + std::to_string(id) + "\ttag" + std::to_string(rng() % 20) + "\n";
+    }
+
+    int load(const std::string &path, int conns, int depth, long total, int songs) {
+        // 1. 预置歌曲
+        std::vector<int> ids;
+        long serverPid = -1;
+        {
+            const int fd = connect_to(path);
+            if (fd < 0) {
+                std::cerr << "无法连接 " << path << "\n";
+                return 1;
+            }
+            serverPid = peer_pid(fd);
+            LineReader reader(fd);
+            for (int done = 0; done < songs;) {
+                const int batch = std::min(256, songs - done);
+                std::string req;
+                for (int i = 0; i < batch; ++i) {
+                    const int n = done + i;
+                    req += "ADD\ttitle " + std::to_string(n) + "\tartist " + std::to_string(n % 997) +
+                           "\t" + std::to_string(120 + n % 300) + "\t" + std::to_string(1 + n % 5) + "\n";
+                }
+                if (!send_all(fd, req))
+                    return 1;
+                std::string header;
+                for (int i = 0; i < batch; ++i) {
+                    std::vector<std::string> lines;
+                    if (!reader.read_response(header, &lines))
+                        return 1;
+                    if (!lines.empty())
+                        ids.push_back(parse_id(lines[0]));
+                }
+                done += batch;
+            }
+            close(fd);
+        }
+        if (ids.empty()) {
+            std::cerr << "预置歌曲失败\n";
+            return 1;
+        }
+
+        // 2. 多连接流水线压测
+        const long rssBefore = rss_kb(serverPid);
+        std::vector<std::vector<double>> latencies(static_cast<std::size_t>(conns));
+        std::vector<long> errors(static_cast<std::size_t>(conns), 0);
+        const long perConn = total / conns;
+        const auto start = Clock::now();
+        std::vector<std::thread> threads;
+        for (int c = 0; c < conns; ++c) {
+            threads.emplace_back([&, c]() {
+                std::mt19937 rng(static_cast<unsigned>(c) + 1);
+                const int fd = connect_to(path);
+                if (fd < 0) {
+                    errors[c] = perConn;
+                    return;
+                }
+                LineReader reader(fd);
+                std::vector<double> &lat = latencies[c];
+                lat.reserve(static_cast<std::size_t>(perConn));
+                std::string header;
+                for (long sent = 0; sent < perConn;) {
+                    const long batch = std::min<long>(depth, perConn - sent);
+                    std::string req;
+                    for (long i = 0; i < batch; ++i)
+                        req += make_request(rng, ids);
+                    const auto t0 = Clock::now();
+                    if (!send_all(fd, req)) {
+                        errors[c] += perConn - sent;
+                        break;
+                    }
+                    for (long i = 0; i < batch; ++i) {
+                        if (!reader.read_response(header, nullptr)) {
+                            errors[c] += batch - i;
+                            break;
+                        }
+                        const std::chrono::duration<double, std::micro> us = Clock::now() - t0;
+                        lat.push_back(us.count());
+                    }
+                    sent += batch;
+                }
+                close(fd);
+            });
+        }
+        for (auto &t : threads)
+            t.join();
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+        std::vector<double> all;
+        long errorCount = 0;
+        for (int c = 0; c < conns; ++c) {
+            all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+            errorCount += errors[c];
+        }
+        if (all.empty()) {
+            std::cerr << "没有完成任何请求\n";
+            return 1;
+        }
+        std::sort(all.begin(), all.end());
+        auto pct = [&](double p) {
+            return all[std::min(all.size() - 1, static_cast<std::size_t>(p * all.size()))];
+        };
+
+        std::printf("connections: %d, pipeline depth: %d, songs: %zu\n", conns, depth, ids.size());
+        std::printf("requests: %zu (errors: %ld) in %.2f s -> %.0f req/s\n", all.size(), errorCount,
+                    elapsed.count(), static_cast<double>(all.size()) / elapsed.count());
+        std::printf("latency us: p50 %.0f  p90 %.0f  p99 %.0f  max %.0f\n", pct(0.50), pct(0.90),
+                    pct(0.99), all.back());
+        const long rssAfter = rss_kb(serverPid);
+        if (rssBefore >= 0 && rssAfter >= 0)
+            std::printf("server RSS kB: %ld before load, %ld after\n", rssBefore, rssAfter);
+        return 0;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "用法: loadgen <套接字> [连接数] [流水线深度] [请求总数] [预置歌曲数]\n"
+                  << "      loadgen <套接字> --replay < 请求文件\n";
+        return 2;
+    }
+    const std::string path = argv[1];
+    if (argc >= 3 && std::string(argv[2]) == "--replay")
+        return replay(path);
+
+    const int conns = argc >= 3 ? std::max(1, std::atoi(argv[2])) : 4;
+    const int depth = argc >= 4 ? std::max(1, std::atoi(argv[3])) : 32;
+    const long total = argc >= 5 ? std::max(1L, std::atol(argv[4])) : 200000;
+    const int songs = argc >= 6 ? std::max(1, std::atoi(argv[5])) : 10000;
+    return load(path, conns, depth, total, songs);
+}
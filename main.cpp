@@ -3,9 +3,15 @@
  * @brief MiniDJ 音乐播放列表管理器的命令行界面 (CLI) 主程序。
  */
 
+#include "Dedup.h"
+#include "Library.h"
+#include "SetBuilder.h"
 #include "Song.h"
+#ifdef MINIDJ_SERVER
+#include "Server.h"
+#endif
 
-#include <algorithm>   // std::sort / std::find_if / std::find_if_not
+#include <algorithm>   // std::find_if_not
 #include <iostream>
 #include <string>
 #include <vector>
@@ -49,7 +55,7 @@ static string read_line(const string& prompt) {
  */
 static bool parse_positive_int(const string& text, int& out) {
     const string s = trim_copy(text);
-    if (s.empty()) return false;
+    if (s.empty() || s.size() > 9) return false; // 9 位以内不会溢出 int
 
     int value = 0;
     for (const char ch : s) {
@@ -77,21 +83,6 @@ static int read_required_positive_int(const string& prompt) {
     }
 }
 
-/**
- * @brief 根据 ID 在播放列表中查找歌曲。
- * @param pl 播放列表 (vector)。
- * @param id 要查找的歌曲 ID。
- * @return 如果找到，返回指向该 Song 对象的指针；否则返回 nullptr。
- */
-static Song* find_by_id(vector<Song>& pl, const int id) {
-    for (auto& s : pl) {
-        if (s.id() == id) {
-            return &s; // 返回找到的 Song 对象的地址
-        }
-    }
-    return nullptr; // 未找到
-}
-
 // --- 核心功能操作 ---
 
 /**
@@ -99,7 +90,7 @@ static Song* find_by_id(vector<Song>& pl, const int id) {
  * 引导用户输入信息，构造 Song 对象。
  * 只有 Song 构造函数确认合法 (s.is_valid()) 后才添加入列。
  */
-static void op_add(vector<Song>& pl) {
+static void op_add(Library& lib) {
     string title  = trim_copy(read_line("标题: "));
     string artist = trim_copy(read_line("艺人: "));
     int duration = read_required_positive_int("时长(秒): ");
@@ -124,47 +115,43 @@ static void op_add(vector<Song>& pl) {
         return;
     }
 
-    pl.push_back(s);
-    cout << "[已添加] " << pl.back() << "\n";
+    lib.add(s);
+    cout << "[已添加] " << s << "\n";
 }
 
 /**
  * @brief (操作 2) 列出所有歌曲。
  */
-static void op_list(const vector<Song>& pl) {
-    if (pl.empty()) {
+static void op_list(const LibrarySnapshot& snap) {
+    if (snap.items.empty()) {
         cout << "[空] 播放列表为空。\n";
         return;
     }
-    for (const auto& s : pl) {
+    snap.items.for_each([](const Song& s) {
         cout << s << "\n";
-    }
+    });
 }
 
 /**
  * @brief (操作 3) 按关键词搜索歌曲。
  * 搜索是大小写不敏感的。
  */
-static void op_search(const vector<Song>& pl) {
+static void op_search(const LibrarySnapshot& snap) {
     const string kw = trim_copy(read_line("关键词: "));
     if (kw.empty()) {
         cout << "[提示] 关键词不能为空。\n";
         return;
     }
 
-    int cnt = 0;
-    for (const auto& s : pl) {
-        if (s.matches_keyword(kw)) {
-            if (cnt == 0) {
-                cout << "[搜索结果]\n";
-            }
-            cout << s << "\n";
-            ++cnt;
-        }
+    const vector<const Song*> hits = snap.search(kw);
+    if (hits.empty()) {
+        cout << "[提示] 未找到匹配项。\n";
+        return;
     }
 
-    if (cnt == 0) {
-        cout << "[提示] 未找到匹配项。\n";
+    cout << "[搜索结果]\n";
+    for (const Song* s : hits) {
+        cout << *s << "\n";
     }
 }
 
@@ -172,15 +159,16 @@ static void op_search(const vector<Song>& pl) {
  * @brief (操作 4) 修改现有歌曲信息。
  * 允许用户对指定 ID 的歌曲的各项属性进行修改，留空表示不修改。
  */
-static void op_edit(vector<Song>& pl) {
+static void op_edit(Library& lib) {
     int id = read_required_positive_int("要修改的歌曲 id: ");
-    Song* p = find_by_id(pl, id);
-    if (!p) {
+    const Library::Snapshot snap = lib.snapshot();
+    const Song* cur = snap->find(id);
+    if (!cur) {
         cout << "[提示] 未找到该 id。\n";
         return;
     }
 
-    cout << "当前： " << *p << "\n（留空=不改）\n";
+    cout << "当前： " << *cur << "\n（留空=不改）\n";
 
     // 读取新信息
     string new_title  = trim_copy(read_line("新标题: "));
@@ -188,58 +176,58 @@ static void op_edit(vector<Song>& pl) {
     string new_dur_str = read_line("新时长(秒): ");
     string new_rate_str = read_line("新评分(1-5): ");
 
-    // 按需更新（只有非空输入才尝试更新）
-    if (!new_title.empty())  p->set_title(new_title);
-    if (!new_artist.empty()) p->set_artist(new_artist);
-
-    int dur = 0;
-    if (!new_dur_str.empty()) {
-        if (parse_positive_int(new_dur_str, dur) && dur > 0) {
-            p->set_duration(dur);
-        } else {
-            cout << "[提示] 时长需正整数，已忽略。\n";
+    // 按需更新（只有非空输入才尝试更新），在副本上修改，有改动才提交新快照
+    lib.update(id, [&](Song& song) {
+        bool changed = false;
+        if (!new_title.empty())  changed = song.set_title(new_title) || changed;
+        if (!new_artist.empty()) changed = song.set_artist(new_artist) || changed;
+
+        int dur = 0;
+        if (!new_dur_str.empty()) {
+            if (parse_positive_int(new_dur_str, dur) && dur > 0) {
+                changed = song.set_duration(dur) || changed;
+            } else {
+                cout << "[提示] 时长需正整数，已忽略。\n";
+            }
         }
-    }
 
-    int rate = 0;
-    if (!new_rate_str.empty()) {
-        if (parse_positive_int(new_rate_str, rate) && rate >= 1 && rate <= 5) {
-            p->set_rating(rate);
-        } else {
-            cout << "[提示] 评分需在 1..5，已忽略。\n";
+        int rate = 0;
+        if (!new_rate_str.empty()) {
+            if (parse_positive_int(new_rate_str, rate) && rate >= 1 && rate <= 5) {
+                changed = song.set_rating(rate) || changed;
+            } else {
+                cout << "[提示] 评分需在 1..5，已忽略。\n";
+            }
         }
-    }
+        return changed;
+    });
 
-    cout << "更新后： " << *p << "\n";
+    cout << "更新后： " << *lib.snapshot()->find(id) << "\n";
 }
 
 /**
  * @brief (操作 7) 删除指定 ID 的歌曲。
  */
-static void op_delete(vector<Song>& pl) {
+static void op_delete(Library& lib) {
     int id = read_required_positive_int("要删除的歌曲 id: ");
 
-    // 使用 std::find_if 和 lambda 表达式来定位迭代器
-    auto it = find_if(pl.begin(), pl.end(), [id](const Song& s){
-        return s.id() == id;
-    });
-
-    if (it == pl.end()) {
+    const Library::Snapshot snap = lib.snapshot();
+    const Song* cur = snap->find(id);
+    if (!cur) {
         cout << "[提示] 未找到该 id。\n";
         return;
     }
 
-    cout << "[已删除] " << *it << "\n";
-    pl.erase(it); // 根据迭代器删除
+    cout << "[已删除] " << *cur << "\n";
+    lib.remove(id);
 }
 
 /**
  * @brief (操作 5) 为指定 ID 的歌曲添加标签。
  */
-static void op_tag_add(vector<Song>& pl) {
+static void op_tag_add(Library& lib) {
     int id = read_required_positive_int("添加标签的歌曲 id: ");
-    Song* p = find_by_id(pl, id);
-    if (!p) {
+    if (!lib.snapshot()->find(id)) {
         cout << "[提示] 未找到该 id。\n";
         return;
     }
@@ -251,18 +239,17 @@ static void op_tag_add(vector<Song>& pl) {
     }
 
     // add_tag 内部会处理重复和打印提示
-    if (p->add_tag(tg)) {
-        cout << "[完成] " << *p << "\n";
+    if (lib.update(id, [&](Song& song) { return song.add_tag(tg); })) {
+        cout << "[完成] " << *lib.snapshot()->find(id) << "\n";
     }
 }
 
 /**
  * @brief (操作 6) 移除指定 ID 歌曲的某个标签。
  */
-static void op_tag_remove(vector<Song>& pl) {
+static void op_tag_remove(Library& lib) {
     const int id = read_required_positive_int("移除标签的歌曲 id: ");
-    Song* p = find_by_id(pl, id);
-    if (!p) {
+    if (!lib.snapshot()->find(id)) {
         cout << "[提示] 未找到该 id。\n";
         return;
     }
@@ -274,8 +261,8 @@ static void op_tag_remove(vector<Song>& pl) {
     }
 
     // remove_tag 内部会处理未找到的情况和打印提示
-    if (p->remove_tag(tg)) {
-        cout << "[完成] " << *p << "\n";
+    if (lib.update(id, [&](Song& song) { return song.remove_tag(tg); })) {
+        cout << "[完成] " << *lib.snapshot()->find(id) << "\n";
     }
 }
 
@@ -283,28 +270,153 @@ static void op_tag_remove(vector<Song>& pl) {
  * @brief (操作 8) 对播放列表进行排序。
  * 排序规则依赖于 Song 定义的 operator<。
  */
-static void op_sort(vector<Song>& pl) {
-    sort(pl.begin(), pl.end());
+static void op_sort(Library& lib) {
+    lib.sort();
     cout << "[完成] 排序已应用。\n";
 }
 
+/**
+ * @brief (操作 9) 撤销上一次修改（添加/修改/标签/删除/排序）。
+ */
+static void op_undo(Library& lib) {
+    if (!lib.undo()) {
+        cout << "[提示] 没有可撤销的操作。\n";
+        return;
+    }
+    cout << "[完成] 已撤销。\n";
+}
+
+/**
+ * @brief (操作 10) 重做最近一次被撤销的修改。
+ */
+static void op_redo(Library& lib) {
+    if (!lib.redo()) {
+        cout << "[提示] 没有可重做的操作。\n";
+        return;
+    }
+    cout << "[完成] 已重做。\n";
+}
+
+/**
+ * @brief (操作 11) 按艺人或标签输出聚合统计（歌曲数、总时长、平均评分、评分分布）。
+ */
+static void op_stats(const Library& lib) {
+    const string by = trim_copy(read_line("统计维度(1=艺人, 2=标签): "));
+    if (by != "1" && by != "2") {
+        cout << "[提示] 请输入 1 或 2。\n";
+        return;
+    }
+
+    const LibraryStats stats = lib.stats();
+    const LibraryStats::Table& table = by == "1" ? stats.by_artist() : stats.by_tag();
+    if (table.empty()) {
+        cout << "[空] 暂无统计数据。\n";
+        return;
+    }
+
+    cout << (by == "1" ? "[按艺人统计]\n" : "[按标签统计]\n");
+    for (const auto& row : LibraryStats::sorted(table)) {
+        cout << LibraryStats::describe(row.first, row.second) << "\n";
+    }
+}
+
+/**
+ * @brief (操作 12) 查找近似重复的歌曲（归一化标题/艺人后相同或高度相似），按组输出。
+ */
+static void op_dedup(const LibrarySnapshot& snap) {
+    vector<const Song*> songs;
+    songs.reserve(snap.byId.size());
+    snap.byId.for_each([&songs](const Song& s) { songs.push_back(&s); });
+
+    const vector<vector<int>> clusters = find_duplicate_clusters(songs);
+    if (clusters.empty()) {
+        cout << "[提示] 未发现重复歌曲。\n";
+        return;
+    }
+
+    cout << "[查重] 发现 " << clusters.size() << " 组疑似重复：\n";
+    for (size_t i = 0; i < clusters.size(); ++i) {
+        cout << "第 " << (i + 1) << " 组:\n";
+        for (int id : clusters[i]) {
+            cout << "  " << *snap.find(id) << "\n";
+        }
+    }
+}
+
+/**
+ * @brief (操作 13) 按目标时长选曲：总时长落在 目标 ± 偏差 内，总评分最大，可限定标签。
+ */
+static void op_build_set(const LibrarySnapshot& snap) {
+    SetRequest req;
+    const int minutes = read_required_positive_int("目标时长(分钟): ");
+    if (minutes > kMaxTargetSec / 60) {
+        cout << "[提示] 目标时长最多 " << kMaxTargetSec / 60 << " 分钟。\n";
+        return;
+    }
+    req.targetSec = minutes * 60;
+
+    const string tol_str = trim_copy(read_line("允许偏差(秒，回车默认30): "));
+    int tolerance = 0;
+    if (!tol_str.empty()) {
+        if (parse_positive_int(tol_str, tolerance) && tolerance <= kMaxTargetSec) {
+            req.toleranceSec = tolerance;
+        } else {
+            cout << "[提示] 偏差需在 0.." << kMaxTargetSec << " 秒，已用默认 30。\n";
+        }
+    }
+    req.tag = trim_copy(read_line("限定标签(回车不限): "));
+
+    vector<const Song*> candidates;
+    candidates.reserve(snap.items.size());
+    snap.items.for_each([&candidates](const Song& s) { candidates.push_back(&s); });
+
+    DjSet set;
+    if (!build_dj_set(candidates, req, set)) {
+        cout << "[提示] 无法凑出该时长的歌单。\n";
+        return;
+    }
+
+    cout << "[选曲] " << set.songs.size() << " 首, 总时长 " << set.totalDuration / 60 << "分"
+         << set.totalDuration % 60 << "秒, 总评分 " << set.totalRating << "\n";
+    for (const Song* s : set.songs) {
+        cout << *s << "\n";
+    }
+}
+
 /**
  * @brief 打印主菜单。
  */
 static void print_menu() {
     cout << "\n=== MiniDJ（接口版）===\n"
-         << "1) 添加   2) 列表   3) 搜索   4) 修改   5) 标签+   6) 标签-   7) 删除   8) 排序   0) 退出\n";
+         << "1) 添加   2) 列表   3) 搜索   4) 修改   5) 标签+   6) 标签-   7) 删除   8) 排序   0) 退出\n"
+         << "9) 撤销   10) 重做   11) 统计   12) 查重   13) 选曲\n";
 }
 
 // --- 主程序 ---
 
-int main() {
+int main(int argc, char* argv[]) {
+#ifdef MINIDJ_SERVER
+    // 服务模式：cpp_exam --serve <套接字路径> [工作线程数]
+    if (argc >= 3 && string(argv[1]) == "--serve") {
+        int workers = 4;
+        if (argc >= 4 && !parse_positive_int(argv[3], workers)) {
+            cout << "[错误] 工作线程数需为正整数\n";
+            return 1;
+        }
+        Library library;
+        return run_server(library, argv[2], workers);
+    }
+#else
+    (void)argc;
+    (void)argv;
+#endif
+
     // 确保 Windows 终端能正确显示 UTF-8 字符（如果需要）
     #ifdef _WIN32
         system("chcp 65001");
     #endif
 
-    vector<Song> playlist;
+    Library library;
 
     for (;;) {  // ;;表示无限循环直到用户选择退出
         print_menu();
@@ -314,14 +426,19 @@ int main() {
         parse_positive_int(op_text, op); // 尝试解析
 
         // 使用扁平的 if-else 结构进行操作分发
-        if (op == 1) op_add(playlist);
-        else if (op == 2) op_list(playlist);
-        else if (op == 3) op_search(playlist);
-        else if (op == 4) op_edit(playlist);
-        else if (op == 5) op_tag_add(playlist);
-        else if (op == 6) op_tag_remove(playlist);
-        else if (op == 7) op_delete(playlist);
-        else if (op == 8) op_sort(playlist);
+        if (op == 1) op_add(library);
+        else if (op == 2) op_list(*library.snapshot());
+        else if (op == 3) op_search(*library.snapshot());
+        else if (op == 4) op_edit(library);
+        else if (op == 5) op_tag_add(library);
+        else if (op == 6) op_tag_remove(library);
+        else if (op == 7) op_delete(library);
+        else if (op == 8) op_sort(library);
+        else if (op == 9) op_undo(library);
+        else if (op == 10) op_redo(library);
+        else if (op == 11) op_stats(library);
+        else if (op == 12) op_dedup(*library.snapshot());
+        else if (op == 13) op_build_set(*library.snapshot());
         else if (op == 0) {
             cout << "Bye!\n";
             break;
@@ -0,0 +1,188 @@
+/**
+ * @file library_stress.cpp
+ * @brief Library 并发压力测试：一个写者不断修改，多个读者校验快照的一致性。
+ *
+ * 每个读者反复取快照并检查：
+ * 1. items、ranked、byId 的歌曲数量相同；
+ * 2. ranked 严格按 operator< 有序，byId 严格按 ID 升序；
+ * 3. ranked 中的每首歌都能在 items 中、以及通过 find() 按 ID 找到，且内容一致；
+ * 4. items 的顺序键严格递增，byId 中每首歌的顺序键与它在 items 中的相同；
+ * 5. 快照上的 search() 结果数量与逐首调用 matches_keyword 的结果一致。
+ * 写者对当前快照中存在的 ID 执行修改/删除时必须成功（包括排序之后）。
+ * 结束时再检查增量维护的聚合统计与从最终快照重新计算的结果一致。
+ * 任一检查失败即返回非 0。
+ */
+
+#include "Library.h"
+#include "Song.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    const char *const kTags[] = {"rock", "pop", "live", "jp", "classic"};
+
+    Song make_song(std::mt19937 &rng, int n) {
+        Song s("title " + std::to_string(n), "artist " + std::to_string(rng() % 50),
+               60 + static_cast<int>(rng() % 400), 1 + static_cast<int>(rng() % 5));
+        s.add_tag(kTags[rng() % 5]);
+        return s;
+    }
+
+    bool same_song(const Song &a, const Song &b) {
+        return a.id() == b.id() && a.title() == b.title() && a.artist() == b.artist() &&
+               a.duration() == b.duration() && a.rating() == b.rating() && a.tags() == b.tags();
+    }
+
+    // 返回发现的问题数量
+    int check_snapshot(const LibrarySnapshot &snap) {
+        int errors = 0;
+        if (snap.items.size() != snap.ranked.size() || snap.items.size() != snap.byId.size())
+            ++errors;
+
+        int prevId = 0;
+        snap.byId.for_each([&](const Song &s) {
+            if (s.id() <= prevId)
+                ++errors;
+            prevId = s.id();
+        });
+
+        std::unordered_map<int, const Song *> byId;
+        snap.items.for_each([&](const Song &s) { byId[s.id()] = &s; });
+
+        std::unordered_map<int, long> keyOf;
+        for (std::size_t i = 0; i < snap.items.size(); ++i) {
+            if (i > 0 && snap.items.key_at(i - 1) >= snap.items.key_at(i))
+                ++errors;
+            keyOf[snap.items.at(i).id()] = snap.items.key_at(i);
+        }
+        for (std::size_t i = 0; i < snap.byId.size(); ++i) {
+            auto it = keyOf.find(snap.byId.at(i).id());
+            if (it == keyOf.end() || it->second != snap.byId.key_at(i))
+                ++errors;
+        }
+
+        const Song *prev = nullptr;
+        std::size_t matches = 0;
+        snap.ranked.for_each([&](const Song &s) {
+            if (prev && !(*prev < s))
+                ++errors;
+            prev = &s;
+            auto it = byId.find(s.id());
+            if (it == byId.end() || !same_song(*it->second, s))
+                ++errors;
+            const Song *found = snap.find(s.id());
+            if (!found || !same_song(*found, s))
+                ++errors;
+            if (s.matches_keyword("rock"))
+                ++matches;
+        });
+
+        if (snap.search("rock").size() != matches)
+            ++errors;
+        return errors;
+    }
+
+    bool same_table(const LibraryStats::Table &a, const LibraryStats::Table &b) {
+        if (a.size() != b.size())
+            return false;
+        for (const auto &kv : a) {
+            auto it = b.find(kv.first);
+            if (it == b.end() || it->second.count != kv.second.count ||
+                it->second.totalDuration != kv.second.totalDuration)
+                return false;
+            for (int r = 0; r < 5; ++r) {
+                if (it->second.ratingHist[r] != kv.second.ratingHist[r])
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    // 返回增量统计与全量重算不一致的表数量
+    int check_stats(const Library &lib) {
+        LibraryStats fresh;
+        lib.snapshot()->items.for_each([&](const Song &s) { fresh.on_added(s); });
+        const LibraryStats incremental = lib.stats();
+        return !same_table(fresh.by_artist(), incremental.by_artist()) +
+               !same_table(fresh.by_tag(), incremental.by_tag());
+    }
+}
+
+int main() {
+    Library lib;
+    std::mt19937 rng(42);
+    int nextTitle = 0;
+    for (int i = 0; i < 2000; ++i) {
+        lib.add(make_song(rng, nextTitle++));
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<int> errors{0};
+    std::atomic<long> snapshots{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                const Library::Snapshot snap = lib.snapshot();
+                errors += check_snapshot(*snap);
+                ++snapshots;
+            }
+        });
+    }
+
+    // 单写者：随机执行各类修改，运行约 1.5 秒
+    long writes = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(1500);
+    while (std::chrono::steady_clock::now() < deadline) {
+        const Library::Snapshot snap = lib.snapshot();
+        const int op = static_cast<int>(rng() % 100);
+        const int id = snap->items.empty()
+                           ? -1
+                           : snap->items.at(rng() % snap->items.size()).id();
+        if (op < 30 || id < 0) {
+            lib.add(make_song(rng, nextTitle++));
+        } else if (op < 50) {
+            const int rating = 1 + static_cast<int>(rng() % 5);
+            errors += !lib.update(id, [&](Song &s) { return s.set_rating(rating); });
+        } else if (op < 60) {
+            const std::string title = "retitled " + std::to_string(nextTitle++);
+            errors += !lib.update(id, [&](Song &s) { return s.set_title(title); });
+        } else if (op < 70) {
+            const char *tag = kTags[rng() % 5];
+            errors += !lib.update(id, [&](Song &s) {
+                bool has = false;
+                for (const auto &t : s.tags())
+                    has = has || t == tag;
+                return has ? s.remove_tag(tag) : s.add_tag(tag);
+            });
+        } else if (op < 85) {
+            errors += !lib.remove(id);
+        } else if (op < 88) {
+            lib.sort();
+        } else if (op < 95) {
+            lib.undo();
+        } else {
+            lib.redo();
+        }
+        ++writes;
+    }
+
+    done = true;
+    for (auto &t : readers)
+        t.join();
+
+    errors += check_snapshot(*lib.snapshot());
+    errors += check_stats(lib);
+
+    std::printf("writes: %ld, snapshots checked: %ld, errors: %d\n", writes, snapshots.load(),
+                errors.load());
+    return errors.load() == 0 ? 0 : 1;
+}